@@ -1,8 +1,173 @@
 
 #include "BasicMeshGroup.h"
 #include "GeometryGenerator.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
 
 namespace jhm {
+
+// 한 vertex에 연결된 edge 수가 이보다 많으면 남는 edge는 마지막 batch에서
+// 직렬로 처리
+static const int MAX_EDGE_COLORS = 64;
+// ParallelFor 한 블록에서 처리할 constraint 수
+static const int SOLVER_GRAIN_SIZE = 1024;
+// self collision: contact를 찾는 거리 = 최소 거리 * 이 값 (iteration 중 이동 여유)
+static const float SELF_CONTACT_MARGIN = 1.5f;
+// self collision filter를 만드는 거리 = 평균 edge 길이 * 이 값 * margin
+// (GUI 최소 거리 슬라이더의 최대값. 슬라이더를 움직여도 다시 만들지 않음)
+static const float COLLISION_FILTER_SCALE = 1.0f;
+// 추정한 spectral radius 상한 (1에 가까우면 omega -> 2 로 발산)
+static const float MAX_CHEBYSHEV_RHO = 0.95f;
+// Blocked GS의 block 당 vertex 수: 위치, 질량과 vertex당 약 3개의 edge
+// (index, 길이)가 약 200KB로 L2에 들어가는 크기
+static const int CONSTRAINT_BLOCK_VERTICES = 4096;
+// UpdateParticles의 ParallelFor 한 블록에서 처리할 triangle 수
+static const int SAMPLING_GRAIN_SIZE = 256;
+// EvaluateParticles의 ParallelFor 한 블록에서 계산할 particle 수
+static const int PARTICLE_GRAIN_SIZE = 4096;
+// 증분 부피 추적을 중단한 뒤 건너뛰는 호출 수의 최대값 (중단마다 두 배)
+static const int MAX_VOLUME_BACKOFF = 16;
+
+// InnerSampling의 triangle 분류. edge k는 꼭짓점 k -> k + 1
+// 짧은 edge 맞은편 꼭짓점이 apex, 짧은 edge의 두 꼭짓점 중 긴 edge 위의 것이
+// longStart, 나머지가 middleStart. normalLength는 apex에서 짧은 edge까지 거리
+struct TriangleLayout {
+    float lengths[3];
+    int shortEdge;
+    int apex;
+    int middleStart;
+    int longStart;
+    float normalLength;
+};
+
+static TriangleLayout ClassifyTriangle(const MeshData &meshData,
+                                       const Triangle &t) {
+    Vector3 pos[3];
+    for (int k = 0; k < 3; ++k)
+        pos[k] = meshData.vertices[t.vertexIndices[k]].position;
+
+    TriangleLayout layout;
+    float *l = layout.lengths;
+    for (int k = 0; k < 3; ++k)
+        l[k] = (pos[k] - pos[(k + 1) % 3]).Length();
+
+    float longEdgeLength = std::max(std::max(l[0], l[1]), l[2]);
+    float shortEdgeLength = std::min(std::min(l[0], l[1]), l[2]);
+
+    int longEdge = longEdgeLength == l[0] ? 0 : longEdgeLength == l[1] ? 1 : 2;
+    if (longEdge == 0)
+        layout.shortEdge = shortEdgeLength == l[1] ? 1 : 2;
+    else if (longEdge == 1)
+        layout.shortEdge = shortEdgeLength == l[0] ? 0 : 2;
+    else
+        layout.shortEdge = shortEdgeLength == l[0] ? 0 : 1;
+
+    layout.apex = (layout.shortEdge + 2) % 3;
+    layout.longStart =
+        layout.apex == longEdge ? (longEdge + 1) % 3 : longEdge;
+    layout.middleStart = 3 - layout.apex - layout.longStart;
+
+    Vector3 shortEdgeVector = pos[layout.middleStart] - pos[layout.longStart];
+    Vector3 longEdgeVector = pos[layout.apex] - pos[layout.longStart];
+
+    Vector3 s = shortEdgeVector.Cross(longEdgeVector.Cross(shortEdgeVector));
+    s.Normalize();
+    layout.normalLength = s.Dot(longEdgeVector);
+    return layout;
+}
+
+// 연속값 x(길이 / particle 간격)가 개수 count의 구간 [count, count + 1)
+// 밖으로 나간 거리. 구간 안이면 -1 (count가 minCount면 아래쪽은 제한 없음)
+static float BandDistance(float x, int count, int minCount) {
+    if (x >= count + 1)
+        return x - (count + 1);
+    if (count > minCount && x < count)
+        return count - x;
+    return -1.0f;
+}
+
+// edge particle 개수가 지금 길이에 맞는 개수에서 벗어난 정도
+static float EdgeDistortion(const MeshData &meshData, UINT edgeIndex,
+                            float d) {
+    const Edge &e = meshData.edges[edgeIndex];
+    float l = (meshData.vertices[e.index0].position -
+               meshData.vertices[e.index1].position)
+                  .Length();
+    const int count = meshData.edgeParticles[edgeIndex].numEdgeParticles;
+    if (count == -1)
+        return FLT_MAX; // 아직 sampling하지 않은 edge
+    return BandDistance(l / d, count, 0);
+}
+
+// 내부 particle 줄 수 / 짧은 edge 방향 개수가 벗어난 정도와 짧은 edge가
+// 바뀌었으면 기존 짧은 edge가 지금 가장 짧은 edge보다 긴 정도
+static float TriangleDistortion(const MeshData &meshData, UINT triangleIndex,
+                                float d) {
+    const Triangle &t = meshData.triangles[triangleIndex];
+    const TriangleParticles &tp = meshData.triangleParticles[triangleIndex];
+    if (tp.shortEdgeIndex == UINT(-1))
+        return FLT_MAX; // 아직 sampling하지 않은 triangle
+    const TriangleLayout layout = ClassifyTriangle(meshData, t);
+    const float shortEdgeLength = layout.lengths[layout.shortEdge];
+
+    float distortion =
+        std::max(BandDistance(layout.normalLength / d,
+                              int(tp.numNormalParticles), 1),
+                 BandDistance(shortEdgeLength / d,
+                              int(tp.numShortEdgeParticles), 1));
+    if (t.edgeIndices[layout.shortEdge] == tp.shortEdgeIndex)
+        return distortion;
+    for (int k = 0; k < 3; ++k)
+        if (t.edgeIndices[k] == tp.shortEdgeIndex)
+            return std::max(distortion,
+                            (layout.lengths[k] - shortEdgeLength) / d);
+    return FLT_MAX; // 짧은 edge가 triangle에서 없어짐 (topology 변경)
+}
+
+// EdgeSampling이 edge를 나누는 구간 수 (particle은 n - 1개)
+static int EdgeSegments(const MeshData &meshData, UINT edgeIndex, float d) {
+    const Edge &e = meshData.edges[edgeIndex];
+    float l = (meshData.vertices[e.index0].position -
+               meshData.vertices[e.index1].position)
+                  .Length();
+    return (int)std::floor(l / d);
+}
+
+// InnerSampling 줄 i의 간격 수. 줄 길이는 짧은 edge의 (1 - i / N) 배
+static int InnerLineParticles(float shortEdgeLength, int numNormalParticles,
+                              int i, float d) {
+    float a = float(i) / numNormalParticles;
+    return std::max(1, (int)std::floor(shortEdgeLength * (1.0f - a) / d));
+}
+
+// InnerSampling이 triangle 내부에 둘 particle 수
+static UINT InnerParticleCount(const MeshData &meshData, UINT triangleIndex,
+                               float d) {
+    const TriangleLayout layout =
+        ClassifyTriangle(meshData, meshData.triangles[triangleIndex]);
+    const float shortEdgeLength = layout.lengths[layout.shortEdge];
+    const int numNormalParticles =
+        std::max(1, (int)std::floor(layout.normalLength / d));
+    UINT count = 0;
+    for (int i = 1; i < numNormalParticles; ++i)
+        count +=
+            InnerLineParticles(shortEdgeLength, numNormalParticles, i, d) - 1;
+    return count;
+}
+
+// particle vertex의 barycentric 좌표 (triangle 꼭짓점 가중치 u, v, 1 - u - v)
+static void SetBarycentric(MeshData &meshData, UINT index, UINT triangle,
+                           float u, float v) {
+    const UINT slot = index - UINT(meshData.particles.Size());
+    meshData.particleTriangles[slot] = triangle;
+    meshData.particleU[slot] = u;
+    meshData.particleV[slot] = v;
+}
 void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
                            const std::string &basePath,
                            const std::string &filename) {
@@ -15,7 +180,7 @@ void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
 void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
                            const std::vector<MeshData> &meshes) {
 
-    // Sampler 
+    // Sampler 만들기
     D3D11_SAMPLER_DESC sampDesc;
     ZeroMemory(&sampDesc, sizeof(sampDesc));
     sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
@@ -27,7 +192,7 @@ void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
     sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
     device->CreateSamplerState(&sampDesc, m_samplerState.GetAddressOf());
 
-    // ConstantBuffer 
+    // ConstantBuffer 만들기
     m_basicVertexConstantData.model = Matrix();
     m_basicVertexConstantData.view = Matrix();
     m_basicVertexConstantData.projection = Matrix();
@@ -46,7 +211,7 @@ void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
     for (const auto &meshData : meshes) {
         auto newMesh = std::make_shared<Mesh>();
 
-        //  shared_ptr  
+        // 복사대신 shared_ptr 사용 고려
         newMesh->m_meshData = meshData;
 
         D3D11Utils::CreatePBDVertexBuffer(device, meshData.vertices,
@@ -63,6 +228,8 @@ void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
                                       newMesh->textureResourceView);
         }
 
+        BuildSolverData(newMesh->m_meshData);
+
         newMesh->vertexConstantBuffer = m_vertexConstantBuffer;
         newMesh->geometryConstantBuffer = m_geometryConstantBuffer;
         newMesh->pixelConstantBuffer = m_pixelConstantBuffer;
@@ -103,23 +270,23 @@ void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
     D3D11Utils::CreatePixelShader(device, L"GSPixelShader.hlsl",
                                   m_basicPixelShader);
 
-    //   ׸
+    // 노멀 벡터 그리기
     m_normalLines = std::make_shared<Mesh>();
 
     std::vector<Vertex> normalVertices;
     std::vector<uint32_t> normalIndices;
 
-    //  ޽ normal  ϳ ġ
+    // 여러 메쉬의 normal 들을 하나로 합치기
     size_t offset = 0;
     for (const auto &meshData : meshes) {
         for (size_t i = 0; i < meshData.vertices.size(); i++) {
 
             auto v = meshData.vertices[i];
 
-            v.texcoord.x = 0.0f; //  ǥ
+            v.texcoord.x = 0.0f; // 시작점 표시
             normalVertices.push_back(v);
 
-            v.texcoord.x = 1.0f; //  ǥ
+            v.texcoord.x = 1.0f; // 끝점 표시
             normalVertices.push_back(v);
 
             normalIndices.push_back(uint32_t(2 * (i + offset)));
@@ -144,6 +311,17 @@ void BasicMeshGroup::Initialize(ComPtr<ID3D11Device> &device,
                                      m_normalVertexConstantBuffer);
 }
 
+void BasicMeshGroup::InitializeSimulation(
+    const std::vector<MeshData> &meshes) {
+    m_meshes.clear();
+    for (const auto &meshData : meshes) {
+        auto newMesh = std::make_shared<Mesh>();
+        newMesh->m_meshData = meshData;
+        BuildSolverData(newMesh->m_meshData);
+        m_meshes.push_back(newMesh);
+    }
+}
+
 void BasicMeshGroup::UpdateConstantBuffers(ComPtr<ID3D11Device> &device,
                                       ComPtr<ID3D11DeviceContext> &context) {
 
@@ -154,7 +332,7 @@ void BasicMeshGroup::UpdateConstantBuffers(ComPtr<ID3D11Device> &device,
     D3D11Utils::UpdateConstantBuffer(device, context, m_basicPixelConstantData,
                              m_pixelConstantBuffer);
 
-    //   ׸
+    // 노멀 벡터 그리기
     if (m_drawNormals && m_drawNormalsDirtyFlag) {
         D3D11Utils::UpdateConstantBuffer(device, context,
                                          m_normalVertexConstantData,
@@ -219,7 +397,7 @@ void BasicMeshGroup::Render(ComPtr<ID3D11DeviceContext> &context) {
             0, 1, mesh->vertexConstantBuffer.GetAddressOf());
         context->GSSetConstantBuffers(
             0, 1, mesh->geometryConstantBuffer.GetAddressOf());
-        // ü   ťʵ  
+        // 물체 렌더링할 때 큐브맵도 같이 사용
         ID3D11ShaderResourceView *resViews[3] = {
             mesh->textureResourceView.Get(), m_diffuseResView.Get(),
             m_specularResView.Get()};
@@ -237,7 +415,7 @@ void BasicMeshGroup::Render(ComPtr<ID3D11DeviceContext> &context) {
         context->DrawIndexed(mesh->m_indexCount, 0, 0);
     }
 
-    //   ׸
+    // 노멀 벡터 그리기
     if (m_drawNormals) {
         context->GSSetShader(nullptr, nullptr, 0);
         context->VSSetShader(m_normalVertexShader.Get(), 0, 0);
@@ -262,441 +440,722 @@ void BasicMeshGroup::InitParticles()
     for (auto& mesh : m_meshes)
     {
         MeshData &meshData = mesh->m_meshData;
-        for (auto &t : meshData.triangles) {
-
-            t.shortEdgeIndex = -1;
-            t.innerParticlesIndices.clear();
-            t.lineParticles.clear();
+        // 기존 particle vertex를 지우고 indices를 triangle 꼭짓점만으로
+        meshData.vertices.resize(meshData.particles.Size());
+        meshData.indices.clear();
+        for (const auto &t : meshData.triangles)
+            for (UINT vertexIndex : t.vertexIndices)
+                meshData.indices.push_back(vertexIndex);
+        meshData.edgeParticles.assign(meshData.edges.size(), EdgeParticles());
+        meshData.triangleParticles.assign(meshData.triangles.size(),
+                                          TriangleParticles());
+        meshData.edgeParticleIndices.Reset(meshData.edges.size());
+        meshData.innerParticleIndices.Reset(meshData.triangles.size());
+        meshData.freeParticles.clear();
+        meshData.particleDrawSlots.clear();
+        meshData.particleTriangles.clear();
+        meshData.particleU.clear();
+        meshData.particleV.clear();
+
+        // edge는 그 edge를 가진 첫 triangle이 sampling
+        meshData.edgeOwners.assign(meshData.edges.size(), UINT(-1));
+        for (UINT i = 0; i < meshData.triangles.size(); ++i) {
+            for (UINT edgeIndex : meshData.triangles[i].edgeIndices)
+                if (meshData.edgeOwners[edgeIndex] == UINT(-1))
+                    meshData.edgeOwners[edgeIndex] = i;
+        }
 
-            Edge &e0 = meshData.edges[t.edgeIndices[0]];
-            Edge &e1 = meshData.edges[t.edgeIndices[1]];
-            Edge &e2 = meshData.edges[t.edgeIndices[2]];
+        // 모든 edge / triangle을 triangle 순서로 sampling
+        auto &queue = meshData.resampleQueue;
+        queue.clear();
+        for (UINT i = 0; i < meshData.triangles.size(); ++i) {
+            for (UINT edgeIndex : meshData.triangles[i].edgeIndices)
+                if (meshData.edgeOwners[edgeIndex] == i)
+                    queue.push_back({FLT_MAX, edgeIndex, false});
+            queue.push_back({FLT_MAX, i, true});
+        }
+        ResampleQueued(meshData, d);
 
-            EdgeSampling(meshData, e0, d);
-            EdgeSampling(meshData, e1, d);
-            EdgeSampling(meshData, e2, d);
+        // 처음 sampling한 개수 기준으로 list마다 여유 slot을 두고 재배치
+        meshData.edgeParticleIndices.Compact();
+        meshData.innerParticleIndices.Compact();
 
-            InnerSampling(meshData, t, d);
-        }
+        EvaluateParticles(meshData);
     }
 }
 
 void BasicMeshGroup::UpdateParticles()
 {
     float d = m_particle_distance;
+    const float hysteresis = m_resampleHysteresis;
+    m_numResamples = 0;
+    m_numDeferredResamples = 0;
 
     for (auto &mesh : m_meshes) {
 
         MeshData &meshData = mesh->m_meshData;
+        const int numTriangles = int(meshData.triangles.size());
+        meshData.resampleCandidates.resize(
+            (numTriangles + SAMPLING_GRAIN_SIZE - 1) / SAMPLING_GRAIN_SIZE);
+
+        // 1) 개수 구간을 hysteresis 이상 벗어난 edge / triangle을 찾음
+        ThreadPool::Get().ParallelFor(
+            0, numTriangles, SAMPLING_GRAIN_SIZE,
+            [&](int begin, int end) {
+                auto &candidates =
+                    meshData.resampleCandidates[begin / SAMPLING_GRAIN_SIZE];
+                candidates.clear();
+                for (int i = begin; i < end; ++i) {
+                    for (UINT edgeIndex : meshData.triangles[i].edgeIndices) {
+                        if (meshData.edgeOwners[edgeIndex] != UINT(i))
+                            continue;
+                        float distortion =
+                            EdgeDistortion(meshData, edgeIndex, d);
+                        if (distortion >= hysteresis)
+                            candidates.push_back(
+                                {distortion, edgeIndex, false});
+                    }
+                    float distortion = TriangleDistortion(meshData, i, d);
+                    if (distortion >= hysteresis)
+                        candidates.push_back({distortion, UINT(i), true});
+                }
+            },
+            m_numThreads);
+
+        // 2) 예산을 넘으면 왜곡이 큰 순서로 (나머지는 다음 프레임에 다시 후보)
+        auto &queue = meshData.resampleQueue;
+        queue.clear();
+        for (const auto &candidates : meshData.resampleCandidates)
+            queue.insert(queue.end(), candidates.begin(), candidates.end());
+        if (m_resampleBudget > 0 && queue.size() > size_t(m_resampleBudget)) {
+            auto priority = [](const ResampleCandidate &a,
+                               const ResampleCandidate &b) {
+                if (a.distortion != b.distortion)
+                    return a.distortion > b.distortion;
+                if (a.triangle != b.triangle)
+                    return a.triangle < b.triangle;
+                return a.index < b.index;
+            };
+            std::nth_element(queue.begin(), queue.begin() + m_resampleBudget,
+                             queue.end(), priority);
+            m_numDeferredResamples += int(queue.size()) - m_resampleBudget;
+            queue.resize(m_resampleBudget);
+            std::sort(queue.begin(), queue.end(), priority);
+        }
+        m_numResamples += int(queue.size());
 
-        for (auto &e : meshData.edges)
-            e.visited = false;
+        // 3) 후보끼리는 particle을 공유하지 않으므로 병렬로 다시 sampling
+        ResampleQueued(meshData, d);
+    }
 
-        for (auto &t : meshData.triangles) {
+    if (m_compactionThreshold > 0.0f)
+        CompactParticles(false);
 
-            Edge &e0 = meshData.edges[t.edgeIndices[0]];
-            Edge &e1 = meshData.edges[t.edgeIndices[1]];
-            Edge &e2 = meshData.edges[t.edgeIndices[2]];
+    for (auto &mesh : m_meshes)
+        EvaluateParticles(mesh->m_meshData);
+}
 
-            EdgeSampling(meshData, e0, d);
-            EdgeSampling(meshData, e1, d);
-            EdgeSampling(meshData, e2, d);
+void BasicMeshGroup::ResampleQueued(MeshData &meshData, float d) {
+    const auto &queue = meshData.resampleQueue;
+    const int numQueued = int(queue.size());
+
+    // 항목별 sampling 뒤 particle 수
+    meshData.resampleTargets.resize(numQueued);
+    ThreadPool::Get().ParallelFor(
+        0, numQueued, SAMPLING_GRAIN_SIZE,
+        [&](int begin, int end) {
+            for (int k = begin; k < end; ++k) {
+                const ResampleCandidate &c = queue[k];
+                meshData.resampleTargets[k] =
+                    c.triangle
+                        ? InnerParticleCount(meshData, c.index, d)
+                        : UINT(std::max(
+                              0, EdgeSegments(meshData, c.index, d) - 1));
+            }
+        },
+        m_numThreads);
+
+    // 늘어나는 수의 prefix sum 순서로 vertex와 list slot을 미리 할당
+    // 큐 순서대로 할당하므로 스레드 수와 무관하게 같은 vertex 번호
+    meshData.reserveOffsets.resize(numQueued + 1);
+    meshData.reservedParticles.clear();
+    for (int k = 0; k < numQueued; ++k) {
+        const ResampleCandidate &c = queue[k];
+        IndexListPool &lists = c.triangle ? meshData.innerParticleIndices
+                                          : meshData.edgeParticleIndices;
+        const UINT target = meshData.resampleTargets[k];
+        meshData.reserveOffsets[k] = UINT(meshData.reservedParticles.size());
+        if (target <= lists.Size(c.index))
+            continue;
+        lists.Reserve(c.index, target);
+        const UINT triangle =
+            c.triangle ? c.index : meshData.edgeOwners[c.index];
+        for (UINT i = lists.Size(c.index); i < target; ++i)
+            meshData.reservedParticles.push_back(
+                AllocParticle(meshData, triangle, 0.0f, 0.0f));
+    }
+    meshData.reserveOffsets[numQueued] =
+        UINT(meshData.reservedParticles.size());
+
+    // 블록 단위로 병렬 sampling, 반납할 vertex는 블록별로 모아 둠
+    const int numBlocks =
+        (numQueued + SAMPLING_GRAIN_SIZE - 1) / SAMPLING_GRAIN_SIZE;
+    meshData.releasedParticles.resize(numBlocks);
+    ThreadPool::Get().ParallelFor(
+        0, numQueued, SAMPLING_GRAIN_SIZE,
+        [&](int begin, int end) {
+            auto &released =
+                meshData.releasedParticles[begin / SAMPLING_GRAIN_SIZE];
+            released.clear();
+            for (int k = begin; k < end; ++k) {
+                const ResampleCandidate &c = queue[k];
+                const UINT offset = meshData.reserveOffsets[k];
+                ParticleSlots slots;
+                slots.reserved = meshData.reservedParticles.data() + offset;
+                slots.numReserved = meshData.reserveOffsets[k + 1] - offset;
+                slots.released = &released;
+                if (c.triangle)
+                    InnerSampling(meshData, c.index, d, &slots);
+                else
+                    EdgeSampling(meshData, c.index, d, &slots);
+            }
+        },
+        m_numThreads);
 
-            InnerSampling(meshData,t, d);
-        }
+    // 블록 순서대로 반납 (다음 할당에서 재사용)
+    for (int b = 0; b < numBlocks; ++b) {
+        for (UINT index : meshData.releasedParticles[b])
+            FreeParticle(meshData, index);
     }
 }
 
-void BasicMeshGroup::EdgeSampling(MeshData& meshData, Edge& e, float d)
-{
-    if (e.visited == false) {
-        int index0 = e.index0;
-        int index1 = e.index1;
-
-        Vector3 pos0 = meshData.vertices[index0].position;
-        Vector3 pos1 = meshData.vertices[index1].position;
-
-        float l = (pos0 - pos1).Length();
-        int n = (int)std::floor(l / d);
-
-        int& numEdgeParticles = e.numEdgeParticles;
-        // Initial
-        if (numEdgeParticles == -1) {
-            numEdgeParticles = n;
-
-            Vector3 p = (pos0 - pos1) / numEdgeParticles;
-
-            Vertex v;
-            for (int i = 1; i < numEdgeParticles; ++i) {
-                v.position = pos1 + p * i;
-                v.normal = (meshData.vertices[index1].normal * (n - i) +
-                            meshData.vertices[index0].normal * i);
-                v.normal.Normalize();
-                v.texcoord = (meshData.vertices[index1].texcoord * (n - i) +
-                              meshData.vertices[index0].texcoord * i);
-
-                e.edgeIndices.push_back(meshData.vertices.size());
-                meshData.indices.push_back(meshData.vertices.size());
-                meshData.vertices.push_back(v);
-            }
-        }
+void BasicMeshGroup::EvaluateParticles(MeshData &meshData) {
+    const int base = int(meshData.particles.Size());
+    const int numSlots = int(meshData.vertices.size()) - base;
+    const DistanceKernelType type = DistanceKernelType(m_particleKernel);
+
+    // mesh vertex 속성을 SoA로 모은 뒤 particle마다 꼭짓점 세 개를 섞음
+    // 반납된 slot도 계산하지만 그리지 않으므로 상관없음
+    ParticleCorners &corners = meshData.particleCorners;
+    corners.Resize(base);
+    ThreadPool::Get().ParallelFor(
+        0, base, PARTICLE_GRAIN_SIZE,
+        [&](int begin, int end) {
+            corners.Copy(meshData.vertices.data(), begin, end);
+        },
+        m_numThreads);
+    ThreadPool::Get().ParallelFor(
+        0, numSlots, PARTICLE_GRAIN_SIZE,
+        [&](int begin, int end) {
+            EvaluateParticleBatch(
+                corners, meshData.triangles.data(),
+                meshData.particleTriangles.data() + begin,
+                meshData.particleU.data() + begin,
+                meshData.particleV.data() + begin,
+                meshData.vertices.data() + base + begin, end - begin, type);
+        },
+        m_numThreads);
+}
 
-        // update
-        else if (numEdgeParticles == n) {
-            Vector3 p = (pos0 - pos1) / numEdgeParticles;
-
-            for (int i = 1; i < numEdgeParticles; ++i) {
-                int index = e.edgeIndices[i - 1];
-                meshData.vertices[index].position = pos1 + p * i;
-                meshData.vertices[index].normal =
-                    (meshData.vertices[index1].normal * (numEdgeParticles - i) +
-                     meshData.vertices[index0].normal * i);
-                meshData.vertices[index].normal.Normalize();
-                meshData.vertices[index].texcoord =
-                    (meshData.vertices[index1].texcoord *
-                         (numEdgeParticles - i) +
-                     meshData.vertices[index0].texcoord * i);
-            }
+float BasicMeshGroup::GetParticleFragmentation(const MeshData &meshData) {
+    const size_t slots = meshData.vertices.size() - meshData.particles.Size();
+    return slots ? float(meshData.freeParticles.size()) / slots : 0.0f;
+}
+
+size_t BasicMeshGroup::CompactParticles(MeshData &meshData) {
+    auto bytes = [&]() {
+        return meshData.vertices.capacity() * sizeof(Vertex) +
+               (meshData.indices.capacity() +
+                meshData.particleDrawSlots.capacity() +
+                meshData.freeParticles.capacity() +
+                meshData.particleTriangles.capacity() +
+                meshData.particleU.capacity() +
+                meshData.particleV.capacity()) *
+                   sizeof(UINT);
+    };
+    const size_t before = bytes();
+    const UINT base = UINT(meshData.particles.Size());
+    const size_t numLive =
+        meshData.vertices.size() - base - meshData.freeParticles.size();
+
+    // 모든 particle은 edge(owner triangle) 또는 triangle list 하나에만 있음
+    std::vector<Vertex> compacted;
+    std::vector<uint32_t> triangles(numLive);
+    AlignedVector<float> u(numLive), v(numLive);
+    compacted.reserve(base + numLive);
+    compacted.assign(meshData.vertices.begin(),
+                     meshData.vertices.begin() + base);
+    auto move = [&](IndexListPool &pool, size_t list) {
+        for (UINT i = 0; i < pool.Size(list); ++i) {
+            UINT &index = pool.At(list, i);
+            const UINT slot = index - base;
+            const size_t to = compacted.size() - base;
+            compacted.push_back(meshData.vertices[index]);
+            triangles[to] = meshData.particleTriangles[slot];
+            u[to] = meshData.particleU[slot];
+            v[to] = meshData.particleV[slot];
+            index = UINT(compacted.size() - 1);
         }
+    };
+    for (UINT t = 0; t < meshData.triangles.size(); ++t) {
+        for (UINT edgeIndex : meshData.triangles[t].edgeIndices)
+            if (meshData.edgeOwners[edgeIndex] == t)
+                move(meshData.edgeParticleIndices, edgeIndex);
+        move(meshData.innerParticleIndices, t);
+    }
+    meshData.vertices.swap(compacted);
+    meshData.particleTriangles.swap(triangles);
+    meshData.particleU.swap(u);
+    meshData.particleV.swap(v);
+
+    // 그리기 목록은 mesh triangle 뒤에 새 번호 순서로
+    const size_t numTriangleIndices = meshData.triangles.size() * 3;
+    meshData.indices.resize(numTriangleIndices + numLive);
+    meshData.particleDrawSlots.resize(numLive);
+    for (UINT i = 0; i < numLive; ++i) {
+        meshData.indices[numTriangleIndices + i] = base + i;
+        meshData.particleDrawSlots[i] = UINT(numTriangleIndices + i);
+    }
+    meshData.indices.shrink_to_fit();
+    meshData.particleDrawSlots.shrink_to_fit();
+    meshData.freeParticles.clear();
+    meshData.freeParticles.shrink_to_fit();
 
-        // resampling
-        else {
-            Vector3 p = (pos0 - pos1) / n;
-
-            // upsampling
-            if (n > numEdgeParticles) {
-                for (int i = 1; i < n; ++i) {
-                    if (i < numEdgeParticles) {
-                        int index = e.edgeIndices[i - 1];
-                        meshData.vertices[index].position = pos1 + p * i;
-                        meshData.vertices[index].normal =
-                            (meshData.vertices[index1].normal * (n - i) +
-                             meshData.vertices[index0].normal * i);
-                        meshData.vertices[index].normal.Normalize();
-                        meshData.vertices[index].texcoord =
-                            (meshData.vertices[index1].texcoord * (n - i) +
-                             meshData.vertices[index0].texcoord * i);
-                    } else {
-
-                        Vertex v;
-                        v.position = pos1 + p * i;
-                        v.normal =
-                            (meshData.vertices[index1].normal * (n - i) +
-                             meshData.vertices[index0].normal * i);
-                        v.normal.Normalize();
-                        v.texcoord =
-                            (meshData.vertices[index1].texcoord * (n - i) +
-                             meshData.vertices[index0].texcoord * i);
-
-                        e.edgeIndices.push_back(meshData.vertices.size());
-                        meshData.indices.push_back(
-                            meshData.vertices.size());
-                        meshData.vertices.push_back(v);
-                    }
-                }
-            }
-            // downsampling
-            else {
-                for (int i = 1; i < numEdgeParticles; ++i) {
-                    if (i < n) {
-                        int index = e.edgeIndices[i - 1];
-                        meshData.vertices[index].position = pos1 + p * i;
-                        meshData.vertices[index].normal =
-                            (meshData.vertices[index1].normal * (n - i) +
-                             meshData.vertices[index0].normal * i);
-                        meshData.vertices[index].normal.Normalize();
-                        meshData.vertices[index].texcoord =
-                            (meshData.vertices[index1].texcoord * (n - i) +
-                             meshData.vertices[index0].texcoord * i);
-                    } else {
-                        // downsampling vertex   scale -> 0
-                        int index = e.edgeIndices.back();
-                        e.edgeIndices.pop_back();
-                        meshData.vertices[index].scale = {0.0f, 0.0f,
-                                                               0.0f};
-                    }
-                }
-            }
-            numEdgeParticles = n;
+    const size_t after = bytes();
+    return before > after ? before - after : 0;
+}
+
+void BasicMeshGroup::CompactParticles(bool force) {
+    using Clock = std::chrono::high_resolution_clock;
+    auto start = Clock::now();
+    size_t reclaimed = 0;
+    bool compacted = false;
+    for (auto &mesh : m_meshes) {
+        MeshData &meshData = mesh->m_meshData;
+        if (force ||
+            GetParticleFragmentation(meshData) > m_compactionThreshold) {
+            reclaimed += CompactParticles(meshData);
+            compacted = true;
         }
+    }
+    if (!compacted)
+        return;
 
-        e.visited = true;
+    ++m_numCompactions;
+    m_compactionBytes = reclaimed;
+    m_compactionMs =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    m_renderDirty = true;
+}
+
+UINT BasicMeshGroup::AllocParticle(MeshData &meshData, UINT triangle,
+                                   float u, float v, ParticleSlots *slots) {
+    if (slots) {
+        const UINT index = slots->reserved[slots->numUsed++];
+        SetBarycentric(meshData, index, triangle, u, v);
+        return index;
+    }
+    const UINT base = UINT(meshData.particles.Size());
+    UINT index;
+    if (!meshData.freeParticles.empty()) {
+        index = meshData.freeParticles.back();
+        meshData.freeParticles.pop_back();
+        meshData.vertices[index] = Vertex();
+    } else {
+        index = UINT(meshData.vertices.size());
+        meshData.vertices.push_back(Vertex());
+        meshData.particleDrawSlots.push_back(0);
+        meshData.particleTriangles.push_back(0);
+        meshData.particleU.push_back(0.0f);
+        meshData.particleV.push_back(0.0f);
     }
+    meshData.particleDrawSlots[index - base] = UINT(meshData.indices.size());
+    meshData.indices.push_back(index);
+    SetBarycentric(meshData, index, triangle, u, v);
+    return index;
+}
+
+void BasicMeshGroup::FreeParticle(MeshData &meshData, UINT index) {
+    // indices의 마지막 항목(항상 particle)을 빈 자리로 옮김
+    const UINT base = UINT(meshData.particles.Size());
+    const UINT slot = meshData.particleDrawSlots[index - base];
+    const UINT last = meshData.indices.back();
+    meshData.indices[slot] = last;
+    meshData.particleDrawSlots[last - base] = slot;
+    meshData.indices.pop_back();
+    meshData.freeParticles.push_back(index);
 }
 
-void BasicMeshGroup::InnerSampling(MeshData& meshData, Triangle& t, float d)
+void BasicMeshGroup::EdgeSampling(MeshData &meshData, UINT edgeIndex, float d,
+                                  ParticleSlots *slots)
 {
-    // inner particle
-    int index0 = t.vertexIndices[0];
-    int index1 = t.vertexIndices[1];
-    int index2 = t.vertexIndices[2];
+    const Edge &e = meshData.edges[edgeIndex];
+    EdgeParticles &ep = meshData.edgeParticles[edgeIndex];
+    IndexListPool &edgeIndices = meshData.edgeParticleIndices;
 
-    Vector3 pos0 = meshData.vertices[index0].position;
-    Vector3 pos1 = meshData.vertices[index1].position;
-    Vector3 pos2 = meshData.vertices[index2].position;
+    UINT index0 = e.index0;
+    UINT index1 = e.index1;
 
-    Vector3 normal0 = meshData.vertices[index0].normal;
-    Vector3 normal1 = meshData.vertices[index1].normal;
-    Vector3 normal2 = meshData.vertices[index2].normal;
-
-    float l0 = (pos0 - pos1).Length();
-    float l1 = (pos1 - pos2).Length();
-    float l2 = (pos2 - pos0).Length();
-
-    Vector3 longEdge;
-    Vector3 middleEdge;
-    Vector3 shortEdge;
-    Vector3 middleStart;
-    Vector3 longStart;
-    float longEdgeLength = std::max(std::max(l0, l1), l2);
-    float shortEdgeLength = std::min(std::min(l0, l1), l2);
-    int shortEdgeIndex;
-
-    if (longEdgeLength == l0) {
-        if (shortEdgeLength == l1) {
-            shortEdge = pos2 - pos1;
-            shortEdgeIndex = t.edgeIndices[1];
-            middleEdge = pos0 - pos2;
-            longEdge = pos0 - pos1;
-            middleStart = pos2;
-            longStart = pos1;
-        } else {
-            shortEdge = pos2 - pos0;
-            shortEdgeIndex = t.edgeIndices[2];
-            middleEdge = pos1 - pos2;
-            longEdge = pos1 - pos0;
-            middleStart = pos2;
-            longStart = pos0;
-        }
-    } else if (longEdgeLength == l1) {
-        if (shortEdgeLength == l0) {
-            shortEdge = pos0 - pos1;
-            shortEdgeIndex = t.edgeIndices[0];
-            middleEdge = pos2 - pos0;
-            longEdge = pos2 - pos1;
-            middleStart = pos0;
-            longStart = pos1;
-        } else {
-            shortEdge = pos0 - pos2;
-            shortEdgeIndex = t.edgeIndices[2];
-            middleEdge = pos1 - pos0;
-            longEdge = pos1 - pos2;
-            middleStart = pos0;
-            longStart = pos2;
-        }
-    } else {
-        if (shortEdgeLength == l0) {
-            shortEdge = pos1 - pos0;
-            shortEdgeIndex = t.edgeIndices[0];
-            middleEdge = pos2 - pos1;
-            longEdge = pos2 - pos0;
-            middleStart = pos1;
-            longStart = pos0;
-        } else {
-            shortEdge = pos1 - pos2;
-            shortEdgeIndex = t.edgeIndices[1];
-            middleEdge = pos0 - pos1;
-            longEdge = pos0 - pos2;
-            middleStart = pos1;
-            longStart = pos2;
-        }
+    int n = EdgeSegments(meshData, edgeIndex, d);
+
+    int& numEdgeParticles = ep.numEdgeParticles;
+    // 개수가 그대로면 barycentric 좌표도 그대로 (위치는 EvaluateParticles)
+    if (numEdgeParticles == n)
+        return;
+
+    // owner triangle에서 edge 양 끝의 꼭짓점 번호
+    const UINT triangleIndex = meshData.edgeOwners[edgeIndex];
+    const Triangle &t = meshData.triangles[triangleIndex];
+    int corner0 = 0, corner1 = 0;
+    for (int k = 0; k < 3; ++k) {
+        if (t.vertexIndices[k] == index0)
+            corner0 = k;
+        if (t.vertexIndices[k] == index1)
+            corner1 = k;
     }
 
-    Vector3 s = shortEdge.Cross(longEdge.Cross(shortEdge));
-    s.Normalize();
+    // i번째 particle = pos1 + (pos0 - pos1) * i / n
+    UINT count = 0;
+    for (int i = 1; i < n; ++i) {
+        float w[3] = {0.0f, 0.0f, 0.0f};
+        w[corner0] = float(i) / n;
+        w[corner1] = float(n - i) / n;
+        if (count < edgeIndices.Size(edgeIndex))
+            SetBarycentric(meshData, edgeIndices.At(edgeIndex, count),
+                           triangleIndex, w[0], w[1]);
+        else
+            edgeIndices.PushBack(edgeIndex,
+                                 AllocParticle(meshData, triangleIndex, w[0],
+                                               w[1], slots));
+        ++count;
+    }
 
-    float normalLength = s.Dot(longEdge);
+    // downsampling된 vertex는 반납 (다음 할당에서 재사용)
+    while (count < edgeIndices.Size(edgeIndex)) {
+        UINT index = edgeIndices.Back(edgeIndex);
+        edgeIndices.PopBack(edgeIndex);
+        if (slots)
+            slots->released->push_back(index);
+        else
+            FreeParticle(meshData, index);
+    }
+    numEdgeParticles = n;
+}
 
-    int numNormalParticles = (int)std::floor(normalLength / d);
+void BasicMeshGroup::InnerSampling(MeshData &meshData, UINT triangleIndex,
+                                   float d, ParticleSlots *slots)
+{
+    const Triangle &t = meshData.triangles[triangleIndex];
+    TriangleParticles &tp = meshData.triangleParticles[triangleIndex];
+    IndexListPool &innerIndices = meshData.innerParticleIndices;
+
+    // inner particle
+    const TriangleLayout layout = ClassifyTriangle(meshData, t);
+    const int apex = layout.apex;
+    const int middleStart = layout.middleStart;
+    const int longStart = layout.longStart;
+    const UINT shortEdgeIndex = t.edgeIndices[layout.shortEdge];
+    const float shortEdgeLength = layout.lengths[layout.shortEdge];
+
+    int numNormalParticles = (int)std::floor(layout.normalLength / d);
     int numShortEdgeParticles = (int)std::floor(shortEdgeLength / d);
 
     numNormalParticles = std::max(1, numNormalParticles);
     numShortEdgeParticles = std::max(1, numShortEdgeParticles);
 
-    Vector3 middleEdgeUnitVector = middleEdge / numNormalParticles;
-    Vector3 longEdgeUnitVector = longEdge / numNormalParticles;
-
-    // Initial
-    if (t.shortEdgeIndex == -1) {
-        t.shortEdgeIndex = shortEdgeIndex;
-        t.numNormalParticles = numNormalParticles;
-        t.numShortEdgeParticles = numShortEdgeParticles;
-        Vertex inner;
-
-        for (int i = 1; i < numNormalParticles; ++i) {
-            Vector3 i1 = middleStart + middleEdgeUnitVector * i;
-            Vector3 i2 = longStart + longEdgeUnitVector * i;
-            float lineLength = (i1 - i2).Length();
-            int lineParticles = (int)std::floor(lineLength / d);
-            lineParticles = std::max(1, lineParticles);
-            t.lineParticles.push_back(lineParticles);
-            Vector3 d = (i1 - i2) / lineParticles;
-
-            for (int j = 1; j < lineParticles; ++j) {
-                inner.position = i2 + d * j;
-
-                // normal barycentric interpolation
-                float s2 =
-                    ((pos0 - inner.position).Cross(pos1 - inner.position))
-                        .Length();
-                float s1 =
-                    ((pos2 - inner.position).Cross(pos0 - inner.position))
-                        .Length();
-                float s0 =
-                    ((pos1 - inner.position).Cross(pos2 - inner.position))
-                        .Length();
-
-                inner.normal = normal0 * s0 + normal1 * s1 + normal2 * s2;
-
-                inner.normal.Normalize();
-
-                t.innerParticlesIndices.push_back(
-                    meshData.vertices.size());
-                meshData.indices.push_back(meshData.vertices.size());
-                meshData.vertices.push_back(inner);
-            }
+    // 구조가 그대로면 barycentric 좌표도 그대로 (위치는 EvaluateParticles)
+    if (tp.shortEdgeIndex == shortEdgeIndex &&
+        tp.numNormalParticles == UINT(numNormalParticles) &&
+        tp.numShortEdgeParticles == UINT(numShortEdgeParticles))
+        return;
+
+    tp.shortEdgeIndex = shortEdgeIndex;
+    tp.numNormalParticles = numNormalParticles;
+    tp.numShortEdgeParticles = numShortEdgeParticles;
+
+    // 줄 i의 j번째 particle의 꼭짓점 가중치 (a = i / N, b = j / 줄 간격 수)
+    //   apex a, middleStart (1 - a) * b, longStart (1 - a) * (1 - b)
+    // 줄 i는 middleStart -> apex, longStart -> apex의 i / N 지점을 잇는 선분
+    UINT count = 0;
+    for (int i = 1; i < numNormalParticles; ++i) {
+        float a = float(i) / numNormalParticles;
+        int numLine =
+            InnerLineParticles(shortEdgeLength, numNormalParticles, i, d);
+        for (int j = 1; j < numLine; ++j) {
+            float b = float(j) / numLine;
+            float w[3];
+            w[apex] = a;
+            w[middleStart] = (1.0f - a) * b;
+            w[longStart] = (1.0f - a) * (1.0f - b);
+            if (count < innerIndices.Size(triangleIndex))
+                SetBarycentric(meshData, innerIndices.At(triangleIndex, count),
+                               triangleIndex, w[0], w[1]);
+            else
+                innerIndices.PushBack(triangleIndex,
+                                      AllocParticle(meshData, triangleIndex,
+                                                    w[0], w[1], slots));
+            ++count;
         }
     }
 
-    // resampling
-    else if (t.shortEdgeIndex != shortEdgeIndex ||
-             numNormalParticles * numShortEdgeParticles !=
-                 t.numNormalParticles * t.numShortEdgeParticles) {
-        t.shortEdgeIndex = shortEdgeIndex;
-
-        t.numNormalParticles = numNormalParticles;
-        t.numShortEdgeParticles = numShortEdgeParticles;
-        Vertex inner;
-        t.lineParticles.clear();
-
-        int count = 0;
-        for (int i = 1; i < numNormalParticles; ++i) {
-            Vector3 i1 = middleStart + middleEdgeUnitVector * i;
-            Vector3 i2 = longStart + longEdgeUnitVector * i;
-            float l = (i1 - i2).Length();
-            int lineParticles = (int)std::floor(l / d);
-            t.lineParticles.push_back(lineParticles);
-            Vector3 d = (i1 - i2) / lineParticles;
-
-            for (int j = 1; j < lineParticles; ++j) {
-                if (count < t.innerParticlesIndices.size()) {
-                    int idx = t.innerParticlesIndices[count];
-                    Vector3 newPosition = i2 + d * j;
-                    meshData.vertices[idx].position = newPosition;
-
-                    // normal barycentric interpolation
-                    float s2 = ((pos0 - newPosition).Cross(pos1 - newPosition))
-                                   .Length();
-                    float s1 = ((pos2 - newPosition).Cross(pos0 - newPosition))
-                                   .Length();
-                    float s0 = ((pos1 - newPosition).Cross(pos2 - newPosition))
-                                   .Length();
-
-                    meshData.vertices[idx].normal =
-                        normal0 * s0 + normal1 * s1 + normal2 * s2;
-
-                    meshData.vertices[idx].normal.Normalize();
-                } else {
-                    inner.position = i2 + d * j;
-
-                    // normal barycentric interpolation
-                    float s2 =
-                        ((pos0 - inner.position).Cross(pos1 - inner.position))
-                            .Length();
-                    float s1 =
-                        ((pos2 - inner.position).Cross(pos0 - inner.position))
-                            .Length();
-                    float s0 =
-                        ((pos1 - inner.position).Cross(pos2 - inner.position))
-                            .Length();
-
-                    inner.normal = normal0 * s0 + normal1 * s1 + normal2 * s2;
-
-                    inner.normal.Normalize();
-
-                    t.innerParticlesIndices.push_back(
-                        meshData.vertices.size());
-                    meshData.indices.push_back(meshData.vertices.size());
-                    meshData.vertices.push_back(inner);
-                }
-                ++count;
-            }
-        }
-        // downsampling vertex   scale -> 0
-        while (count < t.innerParticlesIndices.size()) {
-            int idx = t.innerParticlesIndices.back();
-            t.innerParticlesIndices.pop_back();
-            meshData.vertices[idx].scale = {0.0f, 0.0f, 0.0f};
-        }
+    // downsampling된 vertex는 반납 (다음 할당에서 재사용)
+    while (count < innerIndices.Size(triangleIndex)) {
+        UINT idx = innerIndices.Back(triangleIndex);
+        innerIndices.PopBack(triangleIndex);
+        if (slots)
+            slots->released->push_back(idx);
+        else
+            FreeParticle(meshData, idx);
     }
+}
 
-    // update
-    else {
-        int count = 0;
-        for (int i = 1; i < t.numNormalParticles; ++i) {
-            Vector3 i1 = middleStart + middleEdgeUnitVector * i;
-            Vector3 i2 = longStart + longEdgeUnitVector * i;
-            float l = (i1 - i2).Length();
+void BasicMeshGroup::Simulate(float dt) {
+    const int numSubsteps = std::max(1, m_numSubsteps);
+    const float h = dt / numSubsteps;
+    m_substepDt = h;
 
-            int lineParticles = t.lineParticles[i - 1];
-            Vector3 d = (i1 - i2) / lineParticles;
+    // GUI 등에서 파라미터가 바뀌면 잠든 island를 모두 깨움
+    const WakeParameters parameters = GetWakeParameters();
+    if (parameters != m_wakeParameters) {
+        m_wakeParameters = parameters;
+        WakeAll();
+    }
+
+    m_broadphaseMs = 0.0;
+    m_narrowphaseMs = 0.0;
+    m_numContacts = 0;
+    m_numColliderCandidates = 0;
+    m_numColliderContacts = 0;
+    m_colliderMs = 0.0;
 
-            for (int j = 1; j < lineParticles; ++j) {
-                int idx = t.innerParticlesIndices[count];
-                Vector3 newPosition = i2 + d * j;
-                meshData.vertices[idx].position = newPosition;
+    bool awake = false;
+    for (auto &mesh : m_meshes) {
+        mesh->m_meshData.residual.iterations = 0;
+        awake = awake || !IsAsleep(mesh->m_meshData);
+    }
+    // 예산을 넘어 미룬 resampling이 남았으면 잠들어 있어도 다음
+    // UpdateParticles가 불리도록 (ExampleApp은 m_renderDirty일 때만 호출)
+    if (m_numDeferredResamples > 0)
+        m_renderDirty = true;
+    if (!awake)
+        return;
+    m_renderDirty = true;
 
-                // normal barycentric interpolation
-                float s2 =
-                    ((pos0 - newPosition).Cross(pos1 - newPosition)).Length();
-                float s1 =
-                    ((pos2 - newPosition).Cross(pos0 - newPosition)).Length();
-                float s0 =
-                    ((pos1 - newPosition).Cross(pos2 - newPosition)).Length();
+    for (int s = 0; s < numSubsteps; ++s) {
+        ApplyExtForces(h);
 
-                meshData.vertices[idx].normal =
-                    normal0 * s0 + normal1 * s1 + normal2 * s2;
+        // XPBD multiplier는 substep마다 0에서 시작
+        if (m_useXPBD)
+            ResetLambdas();
 
-                meshData.vertices[idx].normal.Normalize();
-                ++count;
+        for (auto &mesh : m_meshes) {
+            if (IsAsleep(mesh->m_meshData))
+                continue;
+            if (m_useSelfCollision)
+                FindSelfContacts(mesh->m_meshData);
+            FindColliderCandidates(mesh->m_meshData);
+            SolveConstraints(mesh->m_meshData);
+        }
+
+        Integrate(h);
+    }
+
+    if (m_useSleep) {
+        for (auto &mesh : m_meshes)
+            UpdateSleepState(mesh->m_meshData);
+    }
+}
+
+void BasicMeshGroup::SolveConstraints(MeshData &meshData) {
+    if (m_useChebyshev)
+        ResetChebyshev(meshData);
+
+    float rho =
+        m_chebyshevRho > 0.0f ? m_chebyshevRho : meshData.chebyshevRho;
+    float omega = 1.0f;
+    double previousUpdate = 0.0;
+
+    float previous = FLT_MAX;
+    for (int i = 0; i < m_numIterations; ++i) {
+        // coarse level에서 먼저 긴 파장의 늘어남을 줄임
+        if (m_useMultigrid)
+            SolveMultigridVCycle(meshData.particles, meshData.multigridLevels,
+                                 m_multigridCoarseIterations,
+                                 m_useXPBD ? 1.0f : m_distanceStiffness,
+                                 m_numThreads);
+
+        ProjectDistanceConstraints(meshData);
+        if (m_useSelfCollision)
+            ProjectSelfContacts(meshData);
+        if (!meshData.colliderCandidates.empty())
+            ProjectColliderContacts(meshData);
+        SolveOverpressureConstraints(meshData);
+        ++meshData.residual.iterations;
+
+        if (m_useChebyshev) {
+            if (i < m_chebyshevWarmup)
+                omega = 1.0f;
+            else if (i == m_chebyshevWarmup)
+                omega = 2.0f / (2.0f - rho * rho);
+            else
+                omega = 4.0f / (4.0f - rho * rho * omega);
+
+            // warm-up 동안은 연속한 변화량의 비율로 spectral radius 추정
+            double update = ApplyChebyshev(meshData, omega);
+            if (i < m_chebyshevWarmup && m_chebyshevRho <= 0.0f &&
+                previousUpdate > 0.0) {
+                rho = std::min(float(std::sqrt(update / previousUpdate)),
+                               MAX_CHEBYSHEV_RHO);
+                meshData.chebyshevRho = rho;
             }
+            previousUpdate = update;
         }
+
+        if (!m_earlyTermination)
+            continue;
+
+        // tolerance 아래로 내려갔거나, 더 반복해도 residual이 거의 줄지 않음
+        // (압력과 edge 길이가 서로 충돌하는 정지 상태)
+        float residual = meshData.residual.Value();
+        if (residual <= m_tolerance ||
+            previous - residual <= m_tolerance * previous)
+            break;
+        previous = residual;
+    }
+
+    if (!meshData.colliderCandidates.empty())
+        m_numColliderContacts += meshData.numColliderContacts;
+}
+
+SolverResidual BasicMeshGroup::GetResidual() const {
+    SolverResidual result;
+    for (auto &mesh : m_meshes) {
+        const SolverResidual &r = mesh->m_meshData.residual;
+        result.maxStrain = std::max(result.maxStrain, r.maxStrain);
+        result.rmsStrain = std::max(result.rmsStrain, r.rmsStrain);
+        result.volumeError = std::max(result.volumeError, r.volumeError);
+        result.iterations = std::max(result.iterations, r.iterations);
+    }
+    return result;
+}
+
+int BasicMeshGroup::GetMultigridLevelCount() const {
+    int count = 0;
+    for (auto &mesh : m_meshes)
+        count = std::max(count, int(mesh->m_meshData.multigridLevels.size()));
+    return count;
+}
+
+void BasicMeshGroup::ResetChebyshev(MeshData &meshData) {
+    const ParticleState &p = meshData.particles;
+    meshData.chebyshevPrevX = p.px;
+    meshData.chebyshevPrevY = p.py;
+    meshData.chebyshevPrevZ = p.pz;
+    meshData.chebyshevCurrX = p.px;
+    meshData.chebyshevCurrY = p.py;
+    meshData.chebyshevCurrZ = p.pz;
+}
+
+double BasicMeshGroup::ApplyChebyshev(MeshData &meshData, float omega) {
+    ParticleState &p = meshData.particles;
+    auto &blockUpdateNorms = meshData.blockUpdateNorms;
+    blockUpdateNorms.assign(
+        (p.Size() + SOLVER_GRAIN_SIZE - 1) / SOLVER_GRAIN_SIZE, 0.0);
+
+    ThreadPool::Get().ParallelFor(
+        0, int(p.Size()), SOLVER_GRAIN_SIZE,
+        [&](int begin, int end) {
+            float *prev[3] = {meshData.chebyshevPrevX.data(),
+                              meshData.chebyshevPrevY.data(),
+                              meshData.chebyshevPrevZ.data()};
+            float *curr[3] = {meshData.chebyshevCurrX.data(),
+                              meshData.chebyshevCurrY.data(),
+                              meshData.chebyshevCurrZ.data()};
+            float *predicted[3] = {p.px.data(), p.py.data(), p.pz.data()};
+
+            double norm = 0.0;
+            for (int axis = 0; axis < 3; ++axis) {
+                for (int i = begin; i < end; ++i) {
+                    float projected = predicted[axis][i];
+                    float d = projected - curr[axis][i];
+                    norm += double(d) * d;
+
+                    float q = omega * (projected - prev[axis][i]) +
+                              prev[axis][i];
+                    prev[axis][i] = curr[axis][i];
+                    curr[axis][i] = q;
+                    predicted[axis][i] = q;
+                }
+            }
+            blockUpdateNorms[begin / SOLVER_GRAIN_SIZE] = norm;
+        },
+        m_numThreads);
+
+    // 블록 순서대로 합산 (스레드 수와 무관)
+    double norm = 0.0;
+    for (double n : blockUpdateNorms)
+        norm += n;
+    return norm;
+}
+
+void BasicMeshGroup::ResetLambdas() {
+    for (auto &mesh : m_meshes) {
+        MeshData &meshData = mesh->m_meshData;
+        std::fill(meshData.edgeLambdas.begin(), meshData.edgeLambdas.end(),
+                  0.0f);
+        std::fill(meshData.coloredLambdas.begin(),
+                  meshData.coloredLambdas.end(), 0.0f);
+        std::fill(meshData.blockedLambdas.begin(),
+                  meshData.blockedLambdas.end(), 0.0f);
+        meshData.volumeLambda = 0.0f;
     }
 }
 
 void BasicMeshGroup::ApplyExtForces(float dt)
 {
     Vector3 gravity(0.0f, -9.8f, 0.0f);
-    float damping = 0.59f;
-    // ʱ() (ü  * ߷  = η) 
+    // substep 크기와 상관없이 1/60초 동안 같은 비율로 감쇠
+    float damping = std::pow(m_damping, dt * 60.0f);
+    // 초기(평형) 상태(물체의 무게 * 중력  = 부력) 가정
     //float density = 1 / m_volume;
     float dragCoefficient = 0.47f;
     float dragArea = 10.0f;
     for (auto &mesh : m_meshes) {
         MeshData &meshData = mesh->m_meshData;
-        for (int i = 0; i < meshData.verticesPBD.size(); ++i) {
-            Vertex v = meshData.vertices[i];
-            VertexPBD vPBD = meshData.verticesPBD[i];
-            Vector3 pos = v.position;
-            Vector3 vel = vPBD.velocity;
-            Vector3 velNorm = vPBD.velocity;
-            velNorm.Normalize();
-
-            ////߷ 
+        if (IsAsleep(meshData))
+            continue;
+        ParticleState &p = meshData.particles;
+        const bool holdSleeping = meshData.numSleepingIslands > 0;
+        for (size_t i = 0; i < p.Size(); ++i) {
+            // 잠든 island는 제자리 (속도 0)
+            if (holdSleeping &&
+                meshData.islands[meshData.vertexIslands[i]].sleeping) {
+                p.px[i] = p.x[i];
+                p.py[i] = p.y[i];
+                p.pz[i] = p.z[i];
+                continue;
+            }
+
+            ////중력 계산
             // vel += gravity * dt;
-            ////η 
+            ////부력 계산
             // Vector3 buoyancy = -gravity * m_cur_volume * density *
             // v2.invMass; vel += buoyancy * dt;
-            ////׷ 
+            ////항력 계산
             // Vector3 drag = - 0.5 * density * vel.Length() * vel.Length() *
             // dragArea * dragCoefficient * velNorm * v2.invMass; vel += drag *
             // dt;
 
-            vel *= damping;
-            vPBD.newPosition = pos + vel * dt;
+            p.vy[i] -= m_gravity * dt;
 
-            meshData.verticesPBD[i].velocity = vel;
-            meshData.verticesPBD[i].newPosition = vPBD.newPosition;
+            p.vx[i] *= damping;
+            p.vy[i] *= damping;
+            p.vz[i] *= damping;
+
+            p.px[i] = p.x[i] + p.vx[i] * dt;
+            p.py[i] = p.y[i] + p.vy[i] * dt;
+            p.pz[i] = p.z[i] + p.vz[i] * dt;
         }
     }
 }
@@ -705,95 +1164,913 @@ void BasicMeshGroup::ProjectDistanceConstraints()
 {
     for (auto& mesh : m_meshes)
     {
-        MeshData &meshData = mesh->m_meshData;
-        for (auto& e : meshData.edges)
-        {
-            this->ProjectDistanceConstraint(meshData, e);
+        ProjectDistanceConstraints(mesh->m_meshData);
+    }
+}
+
+void BasicMeshGroup::ProjectDistanceConstraints(MeshData &meshData) {
+    StrainAccumulator strain;
+
+    if (m_solverType == PBD_SOLVER_COLORED_GAUSS_SEIDEL) {
+        strain = ProjectDistanceConstraintsColored(meshData);
+    } else if (m_solverType == PBD_SOLVER_JACOBI) {
+        strain = ProjectDistanceConstraintsJacobi(meshData);
+    } else if (m_solverType == PBD_SOLVER_BLOCKED_GAUSS_SEIDEL) {
+        strain = ProjectDistanceConstraintsBlocked(meshData);
+    } else {
+        for (int i = 0; i < meshData.edges.size(); ++i) {
+            const Edge &e = meshData.edges[i];
+            float c = this->ProjectDistanceConstraint(
+                meshData, meshData.edges[i],
+                m_useXPBD ? &meshData.edgeLambdas[i] : nullptr);
+            strain.Add(e.restLength > 0.0f ? fabs(c) / e.restLength : 0.0f);
+        }
+    }
+
+    meshData.residual.maxStrain = strain.maxStrain;
+    meshData.residual.rmsStrain = strain.Rms();
+}
+
+// 블록별 residual을 블록 순서대로 합침 (스레드 수와 무관하게 같은 결과)
+static StrainAccumulator MergeBlockStrains(
+    const std::vector<StrainAccumulator> &blockStrains) {
+    StrainAccumulator strain;
+    for (auto &s : blockStrains)
+        strain.Merge(s);
+    return strain;
+}
+
+StrainAccumulator
+BasicMeshGroup::ProjectDistanceConstraintsColored(MeshData &meshData) {
+    StrainAccumulator strain;
+
+    const int numColors = int(meshData.edgeColorOffsets.size()) - 1;
+    const DistanceKernelType kernel =
+        ResolveDistanceKernel(DistanceKernelType(m_distanceKernel));
+    const float alpha = m_distanceCompliance / (m_substepDt * m_substepDt);
+    float *lambdas = m_useXPBD ? meshData.coloredLambdas.data() : nullptr;
+
+    for (int c = 0; c < numColors; ++c) {
+        int begin = meshData.edgeColorOffsets[c];
+        int end = meshData.edgeColorOffsets[c + 1];
+
+        // 같은 color 안의 edge는 서로 독립이므로 순서와 상관없이 병렬 처리
+        // MAX_EDGE_COLORS 번째 batch는 vertex를 공유할 수 있으므로 직렬
+        if (c < MAX_EDGE_COLORS) {
+            auto &blockStrains = meshData.blockStrains;
+            blockStrains.assign(
+                (end - begin + SOLVER_GRAIN_SIZE - 1) / SOLVER_GRAIN_SIZE,
+                StrainAccumulator());
+
+            ThreadPool::Get().ParallelFor(
+                begin, end, SOLVER_GRAIN_SIZE,
+                [&](int blockBegin, int blockEnd) {
+                    ProjectDistanceBatch(
+                        meshData.particles,
+                        &meshData.coloredIndex0[blockBegin],
+                        &meshData.coloredIndex1[blockBegin],
+                        &meshData.coloredRestLength[blockBegin],
+                        lambdas ? lambdas + blockBegin : nullptr,
+                        blockEnd - blockBegin, m_distanceStiffness, alpha,
+                        kernel,
+                        &blockStrains[(blockBegin - begin) /
+                                      SOLVER_GRAIN_SIZE]);
+                },
+                m_numThreads);
+
+            strain.Merge(MergeBlockStrains(blockStrains));
+        } else {
+            ProjectDistanceBatch(meshData.particles,
+                                 &meshData.coloredIndex0[begin],
+                                 &meshData.coloredIndex1[begin],
+                                 &meshData.coloredRestLength[begin],
+                                 lambdas ? lambdas + begin : nullptr,
+                                 end - begin, m_distanceStiffness, alpha,
+                                 DISTANCE_KERNEL_SCALAR, &strain);
         }
     }
+    return strain;
 }
 
-void BasicMeshGroup::ProjectDistanceConstraint(MeshData &meshData, Edge& e) {
-    float k = 0.9f;
+StrainAccumulator
+BasicMeshGroup::ProjectDistanceConstraintsBlocked(MeshData &meshData) {
+    const int numBlocks = int(meshData.blockEdgeOffsets.size()) - 1;
+    const int numIterations = std::max(1, m_blockIterations);
+    const float alpha = m_distanceCompliance / (m_substepDt * m_substepDt);
+    float *lambdas = m_useXPBD ? meshData.blockedLambdas.data() : nullptr;
+
+    // block 내부 edge는 다른 block과 vertex를 공유하지 않으므로 block끼리
+    // 병렬. 한 block의 데이터가 L2에 있는 동안 여러 번 반복한다.
+    // residual은 마지막 반복에서만 누적
+    auto &blockStrains = meshData.blockStrains;
+    blockStrains.assign(numBlocks, StrainAccumulator());
+    ThreadPool::Get().ParallelFor(
+        0, numBlocks, 1,
+        [&](int begin, int end) {
+            for (int b = begin; b < end; ++b) {
+                int first = meshData.blockEdgeOffsets[b];
+                int last = meshData.blockEdgeOffsets[b + 1];
+                for (int i = 0; i < numIterations; ++i)
+                    ProjectDistanceBatch(
+                        meshData.particles, &meshData.blockedIndex0[first],
+                        &meshData.blockedIndex1[first],
+                        &meshData.blockedRestLength[first],
+                        lambdas ? lambdas + first : nullptr, last - first,
+                        m_distanceStiffness, alpha, DISTANCE_KERNEL_SCALAR,
+                        i == numIterations - 1 ? &blockStrains[b] : nullptr);
+            }
+        },
+        m_numThreads);
+    StrainAccumulator strain = MergeBlockStrains(blockStrains);
+
+    // border edge: 이웃 block의 최신 위치로 한 번 (halo)
+    int first = meshData.blockEdgeOffsets[numBlocks];
+    int last = int(meshData.blockedIndex0.size());
+    ProjectDistanceBatch(
+        meshData.particles, meshData.blockedIndex0.data() + first,
+        meshData.blockedIndex1.data() + first,
+        meshData.blockedRestLength.data() + first,
+        lambdas ? lambdas + first : nullptr, last - first, m_distanceStiffness,
+        alpha, DISTANCE_KERNEL_SCALAR, &strain);
+    return strain;
+}
+
+StrainAccumulator
+BasicMeshGroup::ProjectDistanceConstraintsJacobi(MeshData &meshData) {
+    const float alpha = m_distanceCompliance / (m_substepDt * m_substepDt);
+
+    ParticleState &particles = meshData.particles;
+    auto &edgeDeltas = meshData.edgeDeltas;
+    auto &blockStrains = meshData.blockStrains;
+    blockStrains.assign((meshData.edges.size() + SOLVER_GRAIN_SIZE - 1) /
+                            SOLVER_GRAIN_SIZE,
+                        StrainAccumulator());
+
+    // 1) edge별 보정값 계산 (위치는 읽기만 하므로 순서 상관 없음)
+    ThreadPool::Get().ParallelFor(
+        0, int(meshData.edges.size()), SOLVER_GRAIN_SIZE,
+        [&](int begin, int end) {
+            StrainAccumulator &strain = blockStrains[begin / SOLVER_GRAIN_SIZE];
+            for (int i = begin; i < end; ++i) {
+                const Edge &e = meshData.edges[i];
+
+                Vector3 pos1 = particles.Predicted(e.index0);
+                Vector3 pos2 = particles.Predicted(e.index1);
+                float invMass1 = particles.invMass[e.index0];
+                float invMass2 = particles.invMass[e.index1];
+
+                Vector3 n = pos1 - pos2;
+                float c_p1p2 = n.Length() - e.restLength;
+                n.Normalize();
+                strain.Add(e.restLength > 0.0f ? fabs(c_p1p2) / e.restLength
+                                               : 0.0f);
+
+                // XPBD multiplier는 실제로 적용되는 만큼만 누적: 양 끝
+                // vertex는 보정값을 연결된 edge 수로 평균내고 omega를 곱함
+                float dLambda;
+                if (m_useXPBD) {
+                    dLambda = (-c_p1p2 - alpha * meshData.edgeLambdas[i]) /
+                              (invMass1 + invMass2 + alpha);
+                    float invMassSum = invMass1 + invMass2;
+                    if (invMassSum > 0.0f) {
+                        const auto &offsets = meshData.vertexEdgeOffsets;
+                        float degree1 =
+                            float(offsets[e.index0 + 1] - offsets[e.index0]);
+                        float degree2 =
+                            float(offsets[e.index1 + 1] - offsets[e.index1]);
+                        float applied =
+                            invMass1 / degree1 + invMass2 / degree2;
+                        meshData.edgeLambdas[i] +=
+                            dLambda * m_jacobiOmega * applied / invMassSum;
+                    }
+                } else {
+                    dLambda =
+                        -m_distanceStiffness * c_p1p2 / (invMass1 + invMass2);
+                }
+
+                edgeDeltas[2 * i] = n * (invMass1 * dLambda);
+                edgeDeltas[2 * i + 1] = n * (-invMass2 * dLambda);
+            }
+        },
+        m_numThreads);
+
+    // 2) vertex별로 누적 후 평균 * omega 만큼 이동
+    ThreadPool::Get().ParallelFor(
+        0, int(particles.Size()), SOLVER_GRAIN_SIZE,
+        [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                UINT first = meshData.vertexEdgeOffsets[i];
+                UINT last = meshData.vertexEdgeOffsets[i + 1];
+                if (first == last)
+                    continue;
+
+                Vector3 delta(0.0f, 0.0f, 0.0f);
+                for (UINT j = first; j < last; ++j) {
+                    UINT edgeIndex = meshData.vertexEdges[j];
+                    int side = meshData.edges[edgeIndex].index0 == UINT(i) ? 0 : 1;
+                    delta += edgeDeltas[2 * edgeIndex + side];
+                }
+
+                delta *= m_jacobiOmega / float(last - first);
+                particles.px[i] += delta.x;
+                particles.py[i] += delta.y;
+                particles.pz[i] += delta.z;
+            }
+        },
+        m_numThreads);
+
+    return MergeBlockStrains(blockStrains);
+}
+
+void BasicMeshGroup::BuildSolverData(MeshData &meshData) {
+    meshData.halfEdges.Build(meshData);
+    BuildEdgeColoring(meshData);
+    BuildConstraintBlocks(meshData);
+    BuildAdjacency(meshData);
+    BuildIslands(meshData);
+    BuildCollisionFilter(meshData);
+    // LineCut 후에는 이웃이 바뀐 vertex의 cluster만 다시 만듦
+    UpdateMultigridHierarchy(meshData.particles, meshData.edges,
+                             meshData.multigridLevels);
+
+    meshData.edgeLambdas.assign(meshData.edges.size(), 0.0f);
+    meshData.coloredLambdas.assign(meshData.edges.size(), 0.0f);
+    meshData.blockedLambdas.assign(meshData.edges.size(), 0.0f);
+    meshData.volumeLambda = 0.0f;
+}
+
+void BasicMeshGroup::BuildConstraintBlocks(MeshData &meshData) {
+    // vertex 번호가 공간적으로 가깝게 정렬되어 있다고 가정 (로드 시 재배치,
+    // GeometryGenerator는 생성 순서). 번호 구간이 곧 공간 block.
+    const int numBlocks = int((meshData.particles.Size() +
+                               CONSTRAINT_BLOCK_VERTICES - 1) /
+                              CONSTRAINT_BLOCK_VERTICES);
+    auto blockOf = [&](const Edge &e) {
+        int b0 = int(e.index0) / CONSTRAINT_BLOCK_VERTICES;
+        int b1 = int(e.index1) / CONSTRAINT_BLOCK_VERTICES;
+        return b0 == b1 ? b0 : numBlocks; // numBlocks: border
+    };
 
+    std::vector<UINT> counts(numBlocks + 1, 0);
+    for (const auto &e : meshData.edges)
+        ++counts[blockOf(e)];
+
+    meshData.blockEdgeOffsets.assign(numBlocks + 1, 0);
+    for (int b = 0; b < numBlocks; ++b)
+        meshData.blockEdgeOffsets[b + 1] =
+            meshData.blockEdgeOffsets[b] + counts[b];
+
+    std::vector<UINT> cursor(meshData.blockEdgeOffsets.begin(),
+                             meshData.blockEdgeOffsets.end());
+    const size_t numEdges = meshData.edges.size();
+    meshData.blockedIndex0.resize(numEdges);
+    meshData.blockedIndex1.resize(numEdges);
+    meshData.blockedRestLength.resize(numEdges);
+    for (const auto &e : meshData.edges) {
+        UINT slot = cursor[blockOf(e)]++;
+        meshData.blockedIndex0[slot] = e.index0;
+        meshData.blockedIndex1[slot] = e.index1;
+        meshData.blockedRestLength[slot] = e.restLength;
+    }
+}
+
+void BasicMeshGroup::BuildAdjacency(MeshData &meshData) {
+    const size_t numVertices = meshData.particles.Size();
+
+    // vertex -> edge
+    meshData.vertexEdgeOffsets.assign(numVertices + 1, 0);
+    for (auto &e : meshData.edges) {
+        ++meshData.vertexEdgeOffsets[e.index0 + 1];
+        ++meshData.vertexEdgeOffsets[e.index1 + 1];
+    }
+    for (size_t i = 0; i < numVertices; ++i)
+        meshData.vertexEdgeOffsets[i + 1] += meshData.vertexEdgeOffsets[i];
+
+    std::vector<UINT> cursor(meshData.vertexEdgeOffsets.begin(),
+                             meshData.vertexEdgeOffsets.end() - 1);
+    meshData.vertexEdges.resize(meshData.edges.size() * 2);
+    for (UINT i = 0; i < meshData.edges.size(); ++i) {
+        meshData.vertexEdges[cursor[meshData.edges[i].index0]++] = i;
+        meshData.vertexEdges[cursor[meshData.edges[i].index1]++] = i;
+    }
+
+    // vertex -> triangle 꼭짓점
+    meshData.vertexTriangleOffsets.assign(numVertices + 1, 0);
+    for (auto &t : meshData.triangles) {
+        for (int j = 0; j < 3; ++j)
+            ++meshData.vertexTriangleOffsets[t.vertexIndices[j] + 1];
+    }
+    for (size_t i = 0; i < numVertices; ++i)
+        meshData.vertexTriangleOffsets[i + 1] +=
+            meshData.vertexTriangleOffsets[i];
+
+    cursor.assign(meshData.vertexTriangleOffsets.begin(),
+                  meshData.vertexTriangleOffsets.end() - 1);
+    meshData.vertexTriangles.resize(meshData.triangles.size() * 3);
+    for (UINT i = 0; i < meshData.triangles.size(); ++i) {
+        for (UINT j = 0; j < 3; ++j)
+            meshData.vertexTriangles
+                [cursor[meshData.triangles[i].vertexIndices[j]]++] = i * 3 + j;
+    }
+
+    meshData.edgeDeltas.resize(meshData.edges.size() * 2);
+    meshData.triangleDeltas.resize(meshData.triangles.size() * 3);
+    meshData.volumeGradients.resize(numVertices);
+
+    // 증분 부피 추적 캐시는 다음 계산에서 전체를 다시 채움
+    meshData.volumeX.resize(numVertices);
+    meshData.volumeY.resize(numVertices);
+    meshData.volumeZ.resize(numVertices);
+    meshData.triangleVolumes.resize(meshData.triangles.size());
+    meshData.triangleVolumeStamps.assign(meshData.triangles.size(), 0);
+    meshData.vertexVolumeStamps.assign(numVertices, 0);
+    meshData.volumeStamp = 0;
+    meshData.volumeUpdateCount = -1;
+    meshData.volumeBackoff = 0;
+    meshData.volumeSkipCalls = 0;
+}
+
+void BasicMeshGroup::BuildIslands(MeshData &meshData) {
+    const int numVertices = int(meshData.particles.Size());
+
+    // union-find: 항상 작은 번호를 root로 두므로 root = island의 첫 vertex
+    std::vector<int> parent(numVertices);
+    for (int i = 0; i < numVertices; ++i)
+        parent[i] = i;
+    auto find = [&](int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+    for (const auto &e : meshData.edges) {
+        int a = find(e.index0);
+        int b = find(e.index1);
+        if (a != b)
+            parent[std::max(a, b)] = std::min(a, b);
+    }
+
+    // 첫 vertex 순서로 island 번호 부여
+    meshData.vertexIslands.assign(numVertices, -1);
+    meshData.islands.clear();
+    for (int i = 0; i < numVertices; ++i) {
+        int root = find(i);
+        if (root == i) {
+            meshData.vertexIslands[i] = int(meshData.islands.size());
+            meshData.islands.emplace_back();
+        } else {
+            meshData.vertexIslands[i] = meshData.vertexIslands[root];
+        }
+        ++meshData.islands[meshData.vertexIslands[i]].numVertices;
+    }
+    meshData.numSleepingIslands = 0;
+}
+
+void BasicMeshGroup::BuildCollisionFilter(MeshData &meshData) {
+    double lengthSum = 0.0;
+    for (const auto &e : meshData.edges)
+        lengthSum += e.restLength;
+    meshData.averageEdgeLength =
+        meshData.edges.empty() ? 0.0f
+                               : float(lengthSum / meshData.edges.size());
+
+    // 로드한 위치(rest)에서 이미 가까운 쌍 (seam의 겹친 vertex 등)은 처음
+    // 한 번만 찾음. 그 뒤 (LineCut) 변형된 위치로 다시 만들면 그때 닿아 있는
+    // 쌍이 영영 빠지므로 InheritCollisionFilter로 번호만 이어 받음
+    ParticleState &p = meshData.particles;
+    auto &filter = meshData.collisionFilter;
+    if (meshData.collisionFilterVertices == 0) {
+        const float distance = COLLISION_FILTER_SCALE *
+                               meshData.averageEdgeLength *
+                               SELF_CONTACT_MARGIN;
+        filter.clear();
+        if (distance > 0.0f) {
+            meshData.selfCollisionHash.Build(p.x.data(), p.y.data(),
+                                             p.z.data(), int(p.Size()),
+                                             distance, m_numThreads);
+            meshData.selfCollisionHash.FindPairs(distance, nullptr, filter,
+                                                 m_numThreads);
+        }
+        meshData.collisionFilterVertices = p.Size();
+    }
+
+    // edge 양 끝은 항상 충돌로 보지 않음
+    for (const auto &e : meshData.edges)
+        filter.push_back(SpatialHash::PairKey(e.index0, e.index1));
+    std::sort(filter.begin(), filter.end());
+    filter.erase(std::unique(filter.begin(), filter.end()), filter.end());
+}
+
+void BasicMeshGroup::InheritCollisionFilter(
+    MeshData &meshData,
+    const std::vector<std::pair<UINT, UINT>> &sources) {
+    // sources: (새 vertex, 원래 vertex). 원래 vertex가 빠지는 쌍을 새 vertex도
+    // 빠지도록 복사. 새 vertex와 원래 vertex, 새 vertex끼리(잘린 면 양쪽)는
+    // 추가하지 않으므로 서로 충돌함
+    std::vector<std::pair<UINT, UINT>> byOriginal;
+    byOriginal.reserve(sources.size());
+    for (const auto &s : sources)
+        byOriginal.push_back({s.second, s.first});
+    std::sort(byOriginal.begin(), byOriginal.end());
+
+    auto &filter = meshData.collisionFilter;
+    const size_t numPairs = filter.size();
+    auto inherit = [&](UINT original, UINT partner) {
+        auto it = std::lower_bound(byOriginal.begin(), byOriginal.end(),
+                                   std::make_pair(original, UINT(0)));
+        for (; it != byOriginal.end() && it->first == original; ++it)
+            if (it->second != partner)
+                filter.push_back(SpatialHash::PairKey(it->second, partner));
+    };
+    for (size_t i = 0; i < numPairs; ++i) {
+        const UINT a = UINT(filter[i] >> 32);
+        const UINT b = UINT(filter[i] & 0xffffffffu);
+        inherit(a, b);
+        inherit(b, a);
+    }
+    std::sort(filter.begin(), filter.end());
+    filter.erase(std::unique(filter.begin(), filter.end()), filter.end());
+    meshData.collisionFilterVertices = meshData.particles.Size();
+}
+
+float BasicMeshGroup::GetSelfCollisionDistance(const MeshData &meshData) const {
+    return m_selfCollisionScale * meshData.averageEdgeLength;
+}
+
+void BasicMeshGroup::FindSelfContacts(MeshData &meshData) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    const float distance =
+        GetSelfCollisionDistance(meshData) * SELF_CONTACT_MARGIN;
+    if (distance <= 0.0f)
+        return;
+
+    ParticleState &p = meshData.particles;
+    auto start = Clock::now();
+    meshData.selfCollisionHash.Build(p.px.data(), p.py.data(), p.pz.data(),
+                                     int(p.Size()), distance, m_numThreads);
+    auto built = Clock::now();
+    meshData.selfCollisionHash.FindPairs(distance, &meshData.collisionFilter,
+                                         meshData.selfContacts, m_numThreads);
+    auto end = Clock::now();
+
+    m_broadphaseMs +=
+        std::chrono::duration<double, std::milli>(built - start).count();
+    m_narrowphaseMs +=
+        std::chrono::duration<double, std::milli>(end - built).count();
+    m_numContacts += int(meshData.selfContacts.size());
+}
+
+void BasicMeshGroup::ProjectSelfContacts(MeshData &meshData) {
+    const float minDistance = GetSelfCollisionDistance(meshData);
+    ParticleState &p = meshData.particles;
+
+    // 최소 거리보다 가까운 쌍만 밀어냄 (부등식 constraint)
+    for (uint64_t key : meshData.selfContacts) {
+        uint32_t a = uint32_t(key >> 32);
+        uint32_t b = uint32_t(key & 0xffffffffu);
+        float dx = p.px[a] - p.px[b];
+        float dy = p.py[a] - p.py[b];
+        float dz = p.pz[a] - p.pz[b];
+        float len2 = dx * dx + dy * dy + dz * dz;
+        float w = p.invMass[a] + p.invMass[b];
+        if (len2 >= minDistance * minDistance || len2 <= 1e-12f || w <= 0.0f)
+            continue;
+
+        float len = std::sqrt(len2);
+        float s = (minDistance - len) / (w * len);
+        p.px[a] += p.invMass[a] * s * dx;
+        p.py[a] += p.invMass[a] * s * dy;
+        p.pz[a] += p.invMass[a] * s * dz;
+        p.px[b] -= p.invMass[b] * s * dx;
+        p.py[b] -= p.invMass[b] * s * dy;
+        p.pz[b] -= p.invMass[b] * s * dz;
+    }
+}
+
+void BasicMeshGroup::FindColliderCandidates(MeshData &meshData) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    meshData.colliderCandidates.clear();
+    if (!m_colliders || m_colliders->IsEmpty())
+        return;
+
+    auto start = Clock::now();
+    // 이번 substep에 particle이 지나갈 수 있는 범위: 현재 + 예측 위치
+    const ParticleState &p = meshData.particles;
+    ColliderAabb aabb;
+    for (size_t i = 0; i < p.Size(); ++i) {
+        aabb.min = Vector3::Min(aabb.min, Vector3(std::min(p.x[i], p.px[i]),
+                                                  std::min(p.y[i], p.py[i]),
+                                                  std::min(p.z[i], p.pz[i])));
+        aabb.max = Vector3::Max(aabb.max, Vector3(std::max(p.x[i], p.px[i]),
+                                                  std::max(p.y[i], p.py[i]),
+                                                  std::max(p.z[i], p.pz[i])));
+    }
+    aabb.min -= Vector3(m_colliderMargin);
+    aabb.max += Vector3(m_colliderMargin);
+    m_colliders->Query(aabb, meshData.colliderCandidates);
+
+    m_numColliderCandidates += int(meshData.colliderCandidates.size());
+    m_colliderMs +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+}
+
+void BasicMeshGroup::ProjectColliderContacts(MeshData &meshData) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    auto start = Clock::now();
+    ParticleState &p = meshData.particles;
+    auto &blockContacts = meshData.blockColliderContacts;
+    blockContacts.assign(
+        (p.Size() + SOLVER_GRAIN_SIZE - 1) / SOLVER_GRAIN_SIZE, 0);
+
+    // particle마다 독립인 constraint이므로 블록 단위로 병렬 처리
+    ThreadPool::Get().ParallelFor(
+        0, int(p.Size()), SOLVER_GRAIN_SIZE,
+        [&](int begin, int end) {
+            blockContacts[begin / SOLVER_GRAIN_SIZE] =
+                m_colliders->Project(p, meshData.colliderCandidates,
+                                     m_colliderMargin, begin, end);
+        },
+        m_numThreads);
+
+    meshData.numColliderContacts = 0;
+    for (int n : blockContacts)
+        meshData.numColliderContacts += n;
+    m_colliderMs +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+}
+
+void BasicMeshGroup::BuildEdgeColoring(MeshData &meshData) {
+    // Greedy coloring: 양 끝 vertex에서 아직 쓰이지 않은 가장 작은 color 선택
+    std::vector<uint64_t> usedColors(meshData.vertices.size(), 0);
+    std::vector<UINT> edgeColor(meshData.edges.size());
+    std::vector<UINT> colorCount(MAX_EDGE_COLORS + 1, 0);
+
+    for (int i = 0; i < meshData.edges.size(); ++i) {
+        const Edge &e = meshData.edges[i];
+        uint64_t used = usedColors[e.index0] | usedColors[e.index1];
+
+        UINT color = MAX_EDGE_COLORS;
+        for (int c = 0; c < MAX_EDGE_COLORS; ++c) {
+            if ((used & (uint64_t(1) << c)) == 0) {
+                color = c;
+                break;
+            }
+        }
+
+        if (color < MAX_EDGE_COLORS) {
+            usedColors[e.index0] |= uint64_t(1) << color;
+            usedColors[e.index1] |= uint64_t(1) << color;
+        }
+        edgeColor[i] = color;
+        ++colorCount[color];
+    }
+
+    // 사용된 color 수만큼만 batch 생성 (counting sort)
+    int numColors = MAX_EDGE_COLORS;
+    while (numColors > 0 && colorCount[numColors - 1] == 0)
+        --numColors;
+    if (colorCount[MAX_EDGE_COLORS] > 0)
+        numColors = MAX_EDGE_COLORS + 1;
+
+    meshData.edgeColorOffsets.assign(numColors + 1, 0);
+    for (int c = 0; c < numColors; ++c)
+        meshData.edgeColorOffsets[c + 1] =
+            meshData.edgeColorOffsets[c] + colorCount[c];
+
+    std::vector<UINT> cursor(meshData.edgeColorOffsets.begin(),
+                             meshData.edgeColorOffsets.end() - 1);
+    meshData.coloredEdges.resize(meshData.edges.size());
+    for (int i = 0; i < meshData.edges.size(); ++i)
+        meshData.coloredEdges[cursor[edgeColor[i]]++] = i;
+
+    meshData.coloredIndex0.resize(meshData.edges.size());
+    meshData.coloredIndex1.resize(meshData.edges.size());
+    meshData.coloredRestLength.resize(meshData.edges.size());
+    for (size_t i = 0; i < meshData.coloredEdges.size(); ++i) {
+        const Edge &e = meshData.edges[meshData.coloredEdges[i]];
+        meshData.coloredIndex0[i] = e.index0;
+        meshData.coloredIndex1[i] = e.index1;
+        meshData.coloredRestLength[i] = e.restLength;
+    }
+}
+
+float BasicMeshGroup::ProjectDistanceConstraint(MeshData &meshData, Edge &e,
+                                                float *lambda) {
     UINT index0 = e.index0;
     UINT index1 = e.index1;
     float restLength = e.restLength;
 
-        if (meshData.verticesPBD.size() <= index1)
-        std::cout << meshData.verticesPBD.size() << " " << index1 << std::endl;
+    ParticleState &particles = meshData.particles;
 
-    Vector3 pos1 = meshData.verticesPBD[index0].newPosition;
-    Vector3 pos2 = meshData.verticesPBD[index1].newPosition;
-    float invMass1 = meshData.verticesPBD[index0].invMass;
-    float invMass2 = meshData.verticesPBD[index1].invMass;
+        if (particles.Size() <= index1)
+        std::cout << particles.Size() << " " << index1 << std::endl;
 
-    float c_p1p2 = (pos1 - pos2).Length() - restLength;
+    Vector3 pos1 = particles.Predicted(index0);
+    Vector3 pos2 = particles.Predicted(index1);
+    float invMass1 = particles.invMass[index0];
+    float invMass2 = particles.invMass[index1];
 
-    Vector3 dp1 = (pos1 - pos2);
-    Vector3 dp2 = (pos1 - pos2);
-    dp1.Normalize();
-    dp2.Normalize();
-    dp1 *= -invMass1 / (invMass1 + invMass2) * c_p1p2;
-    dp2 *= invMass2 / (invMass1 + invMass2) * c_p1p2;
-    pos1 += k * dp1;
-    pos2 += k * dp2;
+    Vector3 n = pos1 - pos2;
+    float c_p1p2 = n.Length() - restLength;
+    n.Normalize();
+
+    // PBD:  dLambda = -k * C / (w1 + w2)
+    // XPBD: dLambda = (-C - alpha * lambda) / (w1 + w2 + alpha),
+    //       alpha = compliance / dt^2
+    float dLambda;
+    if (lambda) {
+        float alpha = m_distanceCompliance / (m_substepDt * m_substepDt);
+        dLambda = (-c_p1p2 - alpha * *lambda) / (invMass1 + invMass2 + alpha);
+        *lambda += dLambda;
+    } else {
+        dLambda = -m_distanceStiffness * c_p1p2 / (invMass1 + invMass2);
+    }
 
-    meshData.verticesPBD[index0].newPosition = pos1;
-    meshData.verticesPBD[index1].newPosition = pos2;
+    pos1 += n * (invMass1 * dLambda);
+    pos2 -= n * (invMass2 * dLambda);
 
+    particles.SetPredicted(index0, pos1);
+    particles.SetPredicted(index1, pos2);
 
-    //  ,   Ʈ
-    // meshData.verticesPBD[index0].gradPosition += k * dp1;
-    // meshData.verticesPBD[index1].gradPosition += k * dp2;
-    
+    return c_p1p2;
 }
 
 void BasicMeshGroup::SolveOverpressureConstraints()
 {
     for (auto &mesh : m_meshes) {
-        MeshData &meshData = mesh->m_meshData;
-        float constraintScale = this->computeVolumeConstraintScaling(meshData); 
-        
-        for (auto &t : meshData.triangles) {
+        SolveOverpressureConstraints(mesh->m_meshData);
+    }
+}
 
-            this->solveOverpressureConstraint(meshData, t, constraintScale);
-        }
-        
+void BasicMeshGroup::SolveOverpressureConstraints(MeshData &meshData) {
+    float constraintScale = this->computeVolumeConstraintScaling(meshData);
+
+    if (m_solverType == PBD_SOLVER_JACOBI) {
+        SolveOverpressureConstraintsJacobi(meshData, constraintScale);
+        return;
+    }
+
+    for (auto &t : meshData.triangles) {
+        this->solveOverpressureConstraint(meshData, t, constraintScale);
     }
 }
 
 float BasicMeshGroup::computeVolumeConstraintScaling(MeshData& meshData)
 {
-    std::vector<Vector3> grad(meshData.verticesPBD.size(),
-                              Vector3(0.0, 0.0, 0.0));
-    float curVolume = 0.0f;
-    float gradSum = 0.0f;
-    for (auto &t : meshData.triangles) {
-        int index0 = t.vertexIndices[0];
-        int index1 = t.vertexIndices[1];
-        int index2 = t.vertexIndices[2];
+    double curVolumeSum = 0.0, gradSumTotal = 0.0;
+    if (m_volumeTracking == VOLUME_TRACKING_FULL ||
+        !UpdateVolumeIncremental(meshData, curVolumeSum, gradSumTotal))
+        ComputeVolumeFull(meshData, curVolumeSum, gradSumTotal);
+    if (m_volumeTracking == VOLUME_TRACKING_VERIFY)
+        m_volumeDrift =
+            MeasureVolumeDrift(meshData, curVolumeSum, gradSumTotal);
+
+    float curVolume = float(curVolumeSum);
+    float gradSum = float(gradSumTotal);
+
+    float targetVolume = meshData.m_volume * m_volumePressure;
+    float c_p1p2p3 = curVolume - targetVolume;
+    meshData.residual.volumeError =
+        targetVolume != 0.0f ? fabs(c_p1p2p3 / targetVolume) : 0.0f;
+
+    // XPBD: scaling = dLambda (alpha = compliance / dt^2)
+    if (m_useXPBD) {
+        float alpha = m_volumeCompliance / (m_substepDt * m_substepDt);
+        float dLambda =
+            (-c_p1p2p3 - alpha * meshData.volumeLambda) / (gradSum + alpha);
+        meshData.volumeLambda += dLambda;
+        return dLambda;
+    }
 
-        Vector3 pos0 = meshData.verticesPBD[index0].newPosition;
-        Vector3 pos1 = meshData.verticesPBD[index1].newPosition;
-        Vector3 pos2 = meshData.verticesPBD[index2].newPosition;
+    float scaling = -c_p1p2p3 / gradSum;
 
-        grad[index0] += (pos1 - pos0).Cross(pos2 - pos0);
-        grad[index1] += (pos2 - pos1).Cross(pos0 - pos1);
-        grad[index2] += (pos0 - pos2).Cross(pos1 - pos2);
+    return scaling;
+}
 
-        curVolume += pos0.Cross(pos1).Dot(pos2);
+void BasicMeshGroup::ComputeVolumeFull(MeshData &meshData, double &volume,
+                                       double &gradSum) {
+    ParticleState &particles = meshData.particles;
+    auto &triangleDeltas = meshData.triangleDeltas;
+    auto &gradients = meshData.volumeGradients;
+
+    const int numTriangles = int(meshData.triangles.size());
+    const int numVertices = int(particles.Size());
+    auto &blockVolumes = meshData.blockVolumes;
+    auto &blockGradSums = meshData.blockGradSums;
+    blockVolumes.assign((numTriangles + SOLVER_GRAIN_SIZE - 1) /
+                            SOLVER_GRAIN_SIZE,
+                        0.0);
+    blockGradSums.assign((numVertices + SOLVER_GRAIN_SIZE - 1) /
+                             SOLVER_GRAIN_SIZE,
+                         0.0);
+
+    // 다음 호출에서 증분 갱신을 시도할 때만 캐시를 채움
+    const bool track = m_volumeTracking != VOLUME_TRACKING_FULL &&
+                       meshData.volumeSkipCalls == 0;
+
+    // 1) triangle 한 번 순회로 꼭짓점별 gradient와 부피를 같이 계산
+    ThreadPool::Get().ParallelFor(
+        0, numTriangles, SOLVER_GRAIN_SIZE,
+        [&](int begin, int end) {
+            double volume = 0.0;
+            for (int i = begin; i < end; ++i) {
+                const Triangle &t = meshData.triangles[i];
+
+                Vector3 pos0 = particles.Predicted(t.vertexIndices[0]);
+                Vector3 pos1 = particles.Predicted(t.vertexIndices[1]);
+                Vector3 pos2 = particles.Predicted(t.vertexIndices[2]);
+
+                triangleDeltas[3 * i] = (pos1 - pos0).Cross(pos2 - pos0);
+                triangleDeltas[3 * i + 1] = (pos2 - pos1).Cross(pos0 - pos1);
+                triangleDeltas[3 * i + 2] = (pos0 - pos2).Cross(pos1 - pos2);
+
+                float tripleProduct = pos0.Cross(pos1).Dot(pos2);
+                if (track)
+                    meshData.triangleVolumes[i] = tripleProduct;
+                volume += tripleProduct;
+            }
+            blockVolumes[begin / SOLVER_GRAIN_SIZE] = volume;
+        },
+        m_numThreads);
+
+    // 2) vertex별 gradient 합 (인접 triangle에서 gather하므로 atomic 불필요)
+    ThreadPool::Get().ParallelFor(
+        0, numVertices, SOLVER_GRAIN_SIZE,
+        [&](int begin, int end) {
+            double gradSum = 0.0;
+            for (int i = begin; i < end; ++i) {
+                UINT first = meshData.vertexTriangleOffsets[i];
+                UINT last = meshData.vertexTriangleOffsets[i + 1];
+
+                Vector3 grad(0.0f, 0.0f, 0.0f);
+                for (UINT j = first; j < last; ++j)
+                    grad += triangleDeltas[meshData.vertexTriangles[j]];
+
+                gradients[i] = grad;
+                gradSum += grad.LengthSquared() * particles.invMass[i];
+            }
+            blockGradSums[begin / SOLVER_GRAIN_SIZE] = gradSum;
+        },
+        m_numThreads);
+
+    // 블록 순서대로 합산 (스레드 수와 무관하게 같은 결과)
+    volume = 0.0;
+    gradSum = 0.0;
+    for (double v : blockVolumes)
+        volume += v;
+    for (double g : blockGradSums)
+        gradSum += g;
+
+    if (track) {
+        std::copy(particles.px.begin(), particles.px.end(),
+                  meshData.volumeX.begin());
+        std::copy(particles.py.begin(), particles.py.end(),
+                  meshData.volumeY.begin());
+        std::copy(particles.pz.begin(), particles.pz.end(),
+                  meshData.volumeZ.begin());
+        meshData.trackedVolume = volume;
+        meshData.trackedGradSum = gradSum;
+        meshData.volumeUpdateCount = 0;
+    } else {
+        // gradient와 triangleDeltas를 캐시 위치와 다르게 덮어썼으므로 다음
+        // 증분 갱신 전에 캐시를 다시 만들어야 함
+        meshData.volumeUpdateCount = -1;
     }
+}
 
-    for (int i = 0; i < grad.size(); ++i) {
-        gradSum += grad[i].LengthSquared() * meshData.verticesPBD[i].invMass;
+bool BasicMeshGroup::UpdateVolumeIncremental(MeshData &meshData,
+                                             double &volume,
+                                             double &gradSum) {
+    // 직전에 바뀐 vertex가 많아서 중단했으면 한동안 검사하지 않음
+    if (meshData.volumeSkipCalls > 0) {
+        --meshData.volumeSkipCalls;
+        return false;
     }
+    if (meshData.volumeUpdateCount < 0 ||
+        meshData.volumeUpdateCount >= m_volumeRefreshInterval)
+        return false;
 
-    float c_p1p2p3 = curVolume - meshData.m_volume * m_volumePressure;
+    ParticleState &particles = meshData.particles;
+    const int numVertices = int(particles.Size());
+    const size_t maxDirty = size_t(m_volumeDirtyRatio * numVertices);
+
+    // 1) 캐시와 위치가 다른 vertex. 너무 많으면 중단하고 전체 계산
+    //    (비교는 전체 vertex를 훑지만 triangle / gradient 계산보다 훨씬 쌈)
+    auto &dirtyVertices = meshData.dirtyVertices;
+    dirtyVertices.clear();
+    for (int i = 0; i < numVertices; ++i) {
+        if (particles.px[i] != meshData.volumeX[i] ||
+            particles.py[i] != meshData.volumeY[i] ||
+            particles.pz[i] != meshData.volumeZ[i]) {
+            if (dirtyVertices.size() >= maxDirty) {
+                meshData.volumeBackoff = std::min(
+                    std::max(1, meshData.volumeBackoff * 2), MAX_VOLUME_BACKOFF);
+                meshData.volumeSkipCalls = meshData.volumeBackoff;
+                return false;
+            }
+            dirtyVertices.push_back(i);
+        }
+    }
+    meshData.volumeBackoff = 0;
+    meshData.numDirtyVertices = int(dirtyVertices.size());
+    ++meshData.volumeUpdateCount;
+
+    // 2) 그 vertex가 속한 triangle (중복은 stamp로 제거)
+    const uint32_t stamp = ++meshData.volumeStamp;
+    auto &dirtyTriangles = meshData.dirtyTriangles;
+    dirtyTriangles.clear();
+    for (UINT v : dirtyVertices) {
+        meshData.volumeX[v] = particles.px[v];
+        meshData.volumeY[v] = particles.py[v];
+        meshData.volumeZ[v] = particles.pz[v];
+        for (UINT j = meshData.vertexTriangleOffsets[v];
+             j < meshData.vertexTriangleOffsets[v + 1]; ++j) {
+            UINT t = meshData.vertexTriangles[j] / 3;
+            if (meshData.triangleVolumeStamps[t] != stamp) {
+                meshData.triangleVolumeStamps[t] = stamp;
+                dirtyTriangles.push_back(t);
+            }
+        }
+    }
 
-    float scaling = -c_p1p2p3 / gradSum;
+    // 3) triangle의 부피 차이를 더하고 gradient 조각을 다시 계산.
+    //    gradient가 바뀌는 vertex는 이 triangle들의 꼭짓점 (dirty의 1-ring)
+    auto &triangleDeltas = meshData.triangleDeltas;
+    dirtyVertices.clear();
+    for (UINT t : dirtyTriangles) {
+        const Triangle &tri = meshData.triangles[t];
+        Vector3 pos0 = particles.Predicted(tri.vertexIndices[0]);
+        Vector3 pos1 = particles.Predicted(tri.vertexIndices[1]);
+        Vector3 pos2 = particles.Predicted(tri.vertexIndices[2]);
+
+        triangleDeltas[3 * t] = (pos1 - pos0).Cross(pos2 - pos0);
+        triangleDeltas[3 * t + 1] = (pos2 - pos1).Cross(pos0 - pos1);
+        triangleDeltas[3 * t + 2] = (pos0 - pos2).Cross(pos1 - pos2);
+
+        float tripleProduct = pos0.Cross(pos1).Dot(pos2);
+        meshData.trackedVolume +=
+            double(tripleProduct) - double(meshData.triangleVolumes[t]);
+        meshData.triangleVolumes[t] = tripleProduct;
+
+        for (int k = 0; k < 3; ++k) {
+            UINT v = tri.vertexIndices[k];
+            if (meshData.vertexVolumeStamps[v] != stamp) {
+                meshData.vertexVolumeStamps[v] = stamp;
+                dirtyVertices.push_back(v);
+            }
+        }
+    }
 
-    return scaling;
+    // 4) vertex별 gradient와 제곱합의 차이
+    for (UINT v : dirtyVertices) {
+        Vector3 grad(0.0f, 0.0f, 0.0f);
+        for (UINT j = meshData.vertexTriangleOffsets[v];
+             j < meshData.vertexTriangleOffsets[v + 1]; ++j)
+            grad += triangleDeltas[meshData.vertexTriangles[j]];
+
+        const Vector3 &old = meshData.volumeGradients[v];
+        meshData.trackedGradSum +=
+            (double(grad.LengthSquared()) - double(old.LengthSquared())) *
+            particles.invMass[v];
+        meshData.volumeGradients[v] = grad;
+    }
+
+    volume = meshData.trackedVolume;
+    gradSum = meshData.trackedGradSum;
+    return true;
+}
+
+double BasicMeshGroup::MeasureVolumeDrift(const MeshData &meshData,
+                                          double volume,
+                                          double gradSum) const {
+    const ParticleState &particles = meshData.particles;
+    std::vector<Vector3> gradients(particles.Size(), Vector3(0.0f));
+    double refVolume = 0.0;
+    for (const auto &t : meshData.triangles) {
+        Vector3 pos0 = particles.Predicted(t.vertexIndices[0]);
+        Vector3 pos1 = particles.Predicted(t.vertexIndices[1]);
+        Vector3 pos2 = particles.Predicted(t.vertexIndices[2]);
+        gradients[t.vertexIndices[0]] += (pos1 - pos0).Cross(pos2 - pos0);
+        gradients[t.vertexIndices[1]] += (pos2 - pos1).Cross(pos0 - pos1);
+        gradients[t.vertexIndices[2]] += (pos0 - pos2).Cross(pos1 - pos2);
+        refVolume += pos0.Cross(pos1).Dot(pos2);
+    }
+    double refGradSum = 0.0;
+    for (size_t i = 0; i < gradients.size(); ++i)
+        refGradSum += gradients[i].LengthSquared() * particles.invMass[i];
+
+    auto relative = [](double value, double reference) {
+        return reference != 0.0 ? fabs(value - reference) / fabs(reference)
+                                 : fabs(value);
+    };
+    return std::max(relative(volume, refVolume),
+                    relative(gradSum, refGradSum));
 }
 
 void BasicMeshGroup::solveOverpressureConstraint(
@@ -802,15 +2079,17 @@ void BasicMeshGroup::solveOverpressureConstraint(
     int index1 = t.vertexIndices[1];
     int index2 = t.vertexIndices[2];
 
-    float k = 1.0f;
+    float k = m_useXPBD ? 1.0f : m_volumeStiffness;
+
+    ParticleState &particles = meshData.particles;
 
-    Vector3 pos1 = meshData.verticesPBD[index0].newPosition;
-    Vector3 pos2 = meshData.verticesPBD[index1].newPosition;
-    Vector3 pos3 = meshData.verticesPBD[index2].newPosition;
+    Vector3 pos1 = particles.Predicted(index0);
+    Vector3 pos2 = particles.Predicted(index1);
+    Vector3 pos3 = particles.Predicted(index2);
 
-    float invMass1 = meshData.verticesPBD[index0].invMass;
-    float invMass2 = meshData.verticesPBD[index1].invMass;
-    float invMass3 = meshData.verticesPBD[index2].invMass;
+    float invMass1 = particles.invMass[index0];
+    float invMass2 = particles.invMass[index1];
+    float invMass3 = particles.invMass[index2];
 
     Vector3 dp1 = (pos2 - pos1).Cross(pos3 - pos1);
     Vector3 dp2 = (pos3 - pos2).Cross(pos1 - pos2);
@@ -824,29 +2103,175 @@ void BasicMeshGroup::solveOverpressureConstraint(
     pos2 += k * dp2;
     pos3 += k * dp3;
 
-    meshData.verticesPBD[index0].newPosition = pos1;
-    meshData.verticesPBD[index1].newPosition = pos2;
-    meshData.verticesPBD[index2].newPosition = pos3;
+    particles.SetPredicted(index0, pos1);
+    particles.SetPredicted(index1, pos2);
+    particles.SetPredicted(index2, pos3);
+}
 
-    //  ,   Ʈ
-    //meshData.verticesPBD[index0].gradPosition += k * dp1;
-    //meshData.verticesPBD[index1].gradPosition += k * dp2;
-    //meshData.verticesPBD[index2].gradPosition += k * dp3;
+void BasicMeshGroup::SolveOverpressureConstraintsJacobi(MeshData &meshData,
+                                                       float scaling) {
+    float k = m_useXPBD ? 1.0f : m_volumeStiffness;
+
+    ParticleState &particles = meshData.particles;
+
+    // computeVolumeConstraintScaling에서 구한 vertex별 gradient를 그대로 사용.
+    // 전체가 하나의 constraint이므로 평균내지 않고 적용 (XPBD volumeLambda도
+    // 적용한 보정값 그대로)
+    ThreadPool::Get().ParallelFor(
+        0, int(particles.Size()), SOLVER_GRAIN_SIZE,
+        [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                Vector3 delta = meshData.volumeGradients[i] *
+                                (k * particles.invMass[i] * scaling);
+                particles.px[i] += delta.x;
+                particles.py[i] += delta.y;
+                particles.pz[i] += delta.z;
+            }
+        },
+        m_numThreads);
 }
 
 void BasicMeshGroup::Integrate(float dt) {
+    const float invDt = 1.0f / dt;
+    for (auto &mesh : m_meshes) {
+        MeshData &meshData = mesh->m_meshData;
+        if (IsAsleep(meshData))
+            continue;
+        ParticleState &p = meshData.particles;
+        const bool holdSleeping = meshData.numSleepingIslands > 0;
+        for (size_t i = 0; i < p.Size(); ++i) {
+            // 같은 메쉬의 volume constraint가 옮긴 위치는 버림
+            if (holdSleeping &&
+                meshData.islands[meshData.vertexIslands[i]].sleeping) {
+                p.px[i] = p.x[i];
+                p.py[i] = p.y[i];
+                p.pz[i] = p.z[i];
+                continue;
+            }
+
+            p.vx[i] = (p.px[i] - p.x[i]) * invDt;
+            p.vy[i] = (p.py[i] - p.y[i]) * invDt;
+            p.vz[i] = (p.pz[i] - p.z[i]) * invDt;
+
+            p.x[i] = p.px[i];
+            p.y[i] = p.py[i];
+            p.z[i] = p.pz[i];
+        }
+    }
+}
+
+void BasicMeshGroup::GatherParticlePositions() {
+    for (auto &mesh : m_meshes) {
+        MeshData &meshData = mesh->m_meshData;
+        // 이번 프레임에 시뮬레이션하지 않은 (잠든) 메쉬는 위치가 그대로
+        if (meshData.residual.iterations == 0)
+            continue;
+        const ParticleState &p = meshData.particles;
+        for (size_t i = 0; i < p.Size(); ++i)
+            meshData.vertices[i].position = p.Position(i);
+    }
+}
+
+void BasicMeshGroup::UpdateSleepState(MeshData &meshData) {
+    if (IsAsleep(meshData))
+        return;
+
+    ParticleState &p = meshData.particles;
+    for (auto &island : meshData.islands)
+        island.kineticEnergy = 0.0f;
+    for (size_t i = 0; i < p.Size(); ++i) {
+        Island &island = meshData.islands[meshData.vertexIslands[i]];
+        if (island.sleeping || p.invMass[i] <= 0.0f)
+            continue;
+        float v2 = p.vx[i] * p.vx[i] + p.vy[i] * p.vy[i] + p.vz[i] * p.vz[i];
+        island.kineticEnergy += 0.5f * v2 / p.invMass[i];
+    }
+
+    bool fellAsleep = false;
+    for (auto &island : meshData.islands) {
+        if (island.sleeping)
+            continue;
+        island.kineticEnergy /= float(std::max(1, island.numVertices));
+        if (island.kineticEnergy < m_sleepEnergy)
+            ++island.restFrames;
+        else
+            island.restFrames = 0;
+
+        if (island.restFrames >= m_sleepFrames) {
+            island.sleeping = true;
+            ++meshData.numSleepingIslands;
+            fellAsleep = true;
+        }
+    }
+
+    // 잠든 island에 남아 있는 작은 속도 제거
+    if (fellAsleep) {
+        for (size_t i = 0; i < p.Size(); ++i) {
+            if (meshData.islands[meshData.vertexIslands[i]].sleeping) {
+                p.vx[i] = 0.0f;
+                p.vy[i] = 0.0f;
+                p.vz[i] = 0.0f;
+            }
+        }
+    }
+}
+
+void BasicMeshGroup::WakeAll() {
     for (auto &mesh : m_meshes) {
-    MeshData &meshData = mesh->m_meshData;
-    for (int i = 0; i < meshData.verticesPBD.size(); ++i) {
-        meshData.verticesPBD[i].velocity =
-            (meshData.verticesPBD[i].newPosition -
-                meshData.vertices[i].position) /
-            dt;
-        meshData.vertices[i].position = meshData.verticesPBD[i].newPosition;
+        MeshData &meshData = mesh->m_meshData;
+        for (auto &island : meshData.islands) {
+            island.sleeping = false;
+            island.restFrames = 0;
         }
+        meshData.numSleepingIslands = 0;
+    }
+    m_renderDirty = true;
+}
+
+void BasicMeshGroup::WakeIsland(MeshData &meshData, int vertexIndex) {
+    if (vertexIndex < 0 || vertexIndex >= int(meshData.vertexIslands.size()))
+        return;
+
+    Island &island = meshData.islands[meshData.vertexIslands[vertexIndex]];
+    if (island.sleeping) {
+        island.sleeping = false;
+        --meshData.numSleepingIslands;
+    }
+    island.restFrames = 0;
+    m_renderDirty = true;
+}
+
+bool BasicMeshGroup::IsAsleep(const MeshData &meshData) const {
+    return !meshData.islands.empty() &&
+           meshData.numSleepingIslands == int(meshData.islands.size());
+}
+
+void BasicMeshGroup::GetIslandCount(int &numSleeping, int &numIslands) const {
+    numSleeping = 0;
+    numIslands = 0;
+    for (auto &mesh : m_meshes) {
+        numSleeping += mesh->m_meshData.numSleepingIslands;
+        numIslands += int(mesh->m_meshData.islands.size());
     }
 }
 
+BasicMeshGroup::WakeParameters BasicMeshGroup::GetWakeParameters() const {
+    return {m_volumePressure,     m_particle_distance,
+            float(m_solverType),  m_jacobiOmega,
+            float(m_numSubsteps), float(m_numIterations),
+            m_damping,            float(m_useXPBD),
+            m_distanceStiffness,  m_volumeStiffness,
+            m_distanceCompliance, m_volumeCompliance,
+            float(m_useMultigrid), float(m_multigridCoarseIterations),
+            float(m_useSelfCollision), m_selfCollisionScale,
+            float(m_useChebyshev), float(m_useSleep),
+            m_gravity,            m_colliderMargin,
+            float(m_blockIterations), m_tolerance,
+            float(m_chebyshevWarmup), m_chebyshevRho,
+            float(m_distanceKernel), m_resampleHysteresis,
+            float(m_resampleBudget)};
+}
+
 bool BasicMeshGroup::IntersectRayMesh(Ray &ray) {
 
     float closedHit = 10000.0f;
@@ -884,7 +2309,7 @@ bool BasicMeshGroup::IntersectRayTriangle(MeshData &meshData, Ray &ray,
     Vector3 pos2 = meshData.vertices[index2].position;
 
     Matrix model = m_basicVertexConstantData.model.Transpose();
-    // World space 浹 
+    // World space에서 충돌 계산
     pos0 = Vector3::Transform(pos0, model);
     pos1 = Vector3::Transform(pos1, model);
     pos2 = Vector3::Transform(pos2, model);
@@ -895,14 +2320,14 @@ bool BasicMeshGroup::IntersectRayTriangle(MeshData &meshData, Ray &ray,
     if (ray.rayDir.Dot(normal) > 0.0f)
         return false;
 
-    //    ſ ٸ 浹 ϴ  Ǵ
+    // 평면과 광선이 수평에 매우 가깝다면 충돌하지 못하는 것으로 판단
     if (abs(ray.rayDir.Dot(normal)) < 1e-6f)
-        return false; // t  0  
+        return false; // t 계산시 0으로 나누기 방지
 
     float t =
         (pos0.Dot(normal) - ray.rayOrigin.Dot(normal)) / ray.rayDir.Dot(normal);
 
-    // ray 
+    // ray 뒤쪽
     if (t < 0)
         return false;
 
@@ -914,7 +2339,7 @@ bool BasicMeshGroup::IntersectRayTriangle(MeshData &meshData, Ray &ray,
     Vector3 cross1 = (pos1 - hit.point).Cross(pos2 - hit.point);
     Vector3 cross2 = (pos2 - hit.point).Cross(pos0 - hit.point);
 
-    // ﰢ ܺ
+    // 삼각형 외부
     if (cross0.Dot(normal) < 0.0f || cross1.Dot(normal) < 0.0f ||
         cross2.Dot(normal) < 0.0f)
         return false;
@@ -935,7 +2360,8 @@ void BasicMeshGroup::MouseDrag(int x, int y, int screenWidth, int screenHeight)
 
     Vector3 prePoint = Vector3::Transform(
         Vector3::Transform(
-            Vector3::Transform(m_dragMeshData->vertices[index0].position, model),
+            Vector3::Transform(m_dragMeshData->particles.Position(index0),
+                               model),
             view),
         projection);
 
@@ -943,20 +2369,23 @@ void BasicMeshGroup::MouseDrag(int x, int y, int screenWidth, int screenHeight)
     m_point.y = -(prePoint.y - 1.0f) / 2.0f * screenHeight;
 
     // delta  = (Interaction Vertices position - mouse position)
-    m_dragMeshData->vertices[index0].position +=
-        (m_dragX * (x - m_point.x) - m_dragY * (y - m_point.y)) * 0.001f;
-    m_dragMeshData->vertices[index1].position +=
-        (m_dragX * (x - m_point.x) - m_dragY * (y - m_point.y)) * 0.001f;
-    m_dragMeshData->vertices[index2].position +=
+    Vector3 delta =
         (m_dragX * (x - m_point.x) - m_dragY * (y - m_point.y)) * 0.001f;
+    ParticleState &particles = m_dragMeshData->particles;
+    for (int index : {index0, index1, index2})
+        particles.SetPosition(index, particles.Position(index) + delta);
+
+    // 잡은 island 깨우기
+    WakeIsland(*m_dragMeshData, index0);
 
     }
 
-void BasicMeshGroup::CheckCut(MeshData &meshData, Edge &e, Vector2 line) {
+void BasicMeshGroup::CheckCut(MeshData &meshData, const Edge &e, EdgeCut &cut,
+                              Vector2 line) {
         Vector3 pos0 = meshData.vertices[e.index0].position;
         Vector3 pos1 = meshData.vertices[e.index1].position;
 
-        // line ⺤Ͷ  (  )
+        // line은 방향벡터라고 가정 (원점을 지나는 직선)
         line.Normalize();
 
         Vector2 edgeDirection = Vector2(pos1) - Vector2(pos0);
@@ -973,95 +2402,90 @@ void BasicMeshGroup::CheckCut(MeshData &meshData, Edge &e, Vector2 line) {
          if (true)
         //if (pos0.z < -1.5f && pos1.z < -1.5f)
         {
-            // 1) (denom ~ 0) ̽
+            // 1) 평행(denom ~ 0) 케이스
             if (fabs(denom) < eps) {
-                // 1-a) ħ(colinear):     
+                // 1-a) 겹침(colinear): 두 점 모두 선 위
                 if (fabs(c0) < eps && fabs(c1) < eps) {
                     Vertex addUpVertex;
-                    VertexPBD addUpVertexPBD;
                     addUpVertex.position = pos0;
                     if (meshData.m_collisionVertices[e.index0] == -1) {
                         meshData.m_collisionVertices[e.index0] =
                             (int)meshData.vertices.size();
                         meshData.vertices.push_back(addUpVertex);
-                        meshData.verticesPBD.push_back(addUpVertexPBD);
+                        meshData.particles.PushBack(pos0);
                         meshData.m_collisionVertices.push_back(-1);
                     }
 
                     Vertex addDownVertex;
-                    VertexPBD addDownVertexPBD;
                     addDownVertex.position = pos1;
                     if (meshData.m_collisionVertices[e.index1] == -1) {
                         meshData.m_collisionVertices[e.index1] =
                             (int)meshData.vertices.size();
                         meshData.vertices.push_back(addDownVertex);
-                        meshData.verticesPBD.push_back(addDownVertexPBD);
+                        meshData.particles.PushBack(pos1);
                         meshData.m_collisionVertices.push_back(-1);
                     }
                 }
 
-                // 1-b) ׳ (ġ ):  
+                // 1-b) 그냥 평행(겹치지 않음): 교차 없음
                 return;
             }
 
-            // 2)  Ķ t (0~1)
+            // 2) 교차 파라미터 t (0~1)
             //    pos = pos0 + t*(pos1-pos0)
 
             float t = c0 / denom;
 
-            // 3)   : t==0 Ǵ t==1
+            // 3) 점 동일 교차: t==0 또는 t==1
             if (fabs(t - 0.0f) < eps) {
                 Vertex addVertex;
-                VertexPBD addVertexPBD;
                 addVertex.position = pos0;
 
                 if (meshData.m_collisionVertices[e.index0] == -1) {
                     meshData.m_collisionVertices[e.index0] =
                         (int)meshData.vertices.size();
                     meshData.vertices.push_back(addVertex);
-                    meshData.verticesPBD.push_back(addVertexPBD);
+                    meshData.particles.PushBack(pos0);
                     meshData.m_collisionVertices.push_back(-1);
                 }
                 return;
             } else if (fabs(t - 1.0f) < eps) {
                 Vertex addVertex;
-                VertexPBD addVertexPBD;
                 addVertex.position = pos0;
 
                 if (meshData.m_collisionVertices[e.index0] == -1) {
                     meshData.m_collisionVertices[e.index0] =
                         (int)meshData.vertices.size();
                     meshData.vertices.push_back(addVertex);
-                    meshData.verticesPBD.push_back(addVertexPBD);
+                    meshData.particles.PushBack(pos0);
                     meshData.m_collisionVertices.push_back(-1);
                 }
                 return;
             }
 
-            // 4)  : 0 < t < 1
+            // 4) 사이 교차: 0 < t < 1
             if (t > 0.0f && t < 1.0f) {
                 Vertex vertexUp, vertexDown;
-                VertexPBD VertexUpPBD, VertexDownPBD;
 
                 Vector3 cutPos = pos0 + t * (pos1 - pos0);
 
                 vertexUp.position = cutPos;
                 vertexDown.position = cutPos;
 
-                e.cutVertexIndexUp = (int)meshData.vertices.size();
+                cut.cutVertexIndexUp = (int)meshData.vertices.size();
                 meshData.vertices.push_back(vertexUp);
-                meshData.verticesPBD.push_back(VertexUpPBD);
+                meshData.particles.PushBack(cutPos);
                 meshData.m_collisionVertices.push_back(-1);
 
-                e.cutVertexIndexDown = (int)meshData.vertices.size();
+                cut.cutVertexIndexDown = (int)meshData.vertices.size();
                 meshData.vertices.push_back(vertexDown);
-                meshData.verticesPBD.push_back(VertexDownPBD);
+                meshData.particles.PushBack(cutPos);
                 meshData.m_collisionVertices.push_back(-1);
 
                 return;
             }
 
-            // 5) ( ٱ ): ƹ͵  
+            // 5) 나머지(선분 바깥 교차): 아무것도 안 함
             return;
         }
     }
@@ -1073,9 +2497,9 @@ void BasicMeshGroup::CutTwoEdge()
 
 void BasicMeshGroup::CutEdge(MeshData &meshData, Triangle &t,
                                 Vector2 line) {
-        Edge e0 = meshData.edges[t.edgeIndices[0]];
-        Edge e1 = meshData.edges[t.edgeIndices[1]];
-        Edge e2 = meshData.edges[t.edgeIndices[2]];
+        EdgeCut e0 = meshData.edgeCuts[t.edgeIndices[0]];
+        EdgeCut e1 = meshData.edgeCuts[t.edgeIndices[1]];
+        EdgeCut e2 = meshData.edgeCuts[t.edgeIndices[2]];
 
         Vector3 checkLine = Vector3(line.x, line.y, 0.0f);
         if (e0.cutVertexIndexDown != -1 && e1.cutVertexIndexDown != -1 &&
@@ -1404,43 +2828,16 @@ void BasicMeshGroup::CutVertex(MeshData &meshData, Triangle &t,
         }
     }
 
-int BasicMeshGroup::AddEdge(MeshData& meshData, int index0, int index1)
-{
-        bool check = false;
-        int idx = 0;
-        int idx0 = std::min(index0, index1);
-        int idx1 = std::max(index0, index1);
-
-        for (auto &e : meshData.edges) {
-            if (e.index0 == idx0 && e.index1 == idx1) {
-
-                check = true;
-                break;
-            }
-            ++idx;
-        }
-
-        if (check == false) {
-            Edge add;
-            add.index0 = idx0;
-            add.index1 = idx1;
-            add.restLength = (meshData.vertices[idx0].position -
-                              meshData.vertices[idx1].position)
-                                 .Length();
-            meshData.edges.push_back(add);
-        }
-
-        return idx;
-    }
-
 void BasicMeshGroup::LineCut(Vector2 line) {
         for (auto &mesh : m_meshes) {
             MeshData &meshData = mesh->m_meshData;
-            meshData.vertices.resize(meshData.verticesPBD.size());  // vertices ִ  particles 
+            meshData.vertices.resize(meshData.particles.Size());  // vertices에 있는 기존 particles 삭제
             meshData.m_collisionVertices.assign(meshData.vertices.size(), -1);
 
-            for (auto &e : meshData.edges) {
-                CheckCut(meshData, e, line);
+            meshData.edgeCuts.assign(meshData.edges.size(), EdgeCut());
+            for (size_t i = 0; i < meshData.edges.size(); ++i) {
+                CheckCut(meshData, meshData.edges[i], meshData.edgeCuts[i],
+                         line);
             }
 
             int initTrianglesSize = meshData.triangles.size();
@@ -1455,8 +2852,31 @@ void BasicMeshGroup::LineCut(Vector2 line) {
                 CutVertex(meshData, meshData.triangles[i], line);
             }
 
+            // 새 vertex는 복사한 vertex / 잘린 edge 양 끝의 collision filter를
+            // 이어 받음 (변형된 지금 위치로 다시 만들지 않음)
+            std::vector<std::pair<UINT, UINT>> filterSources;
+            for (size_t v = 0; v < meshData.m_collisionVertices.size(); ++v) {
+                if (meshData.m_collisionVertices[v] != -1)
+                    filterSources.push_back(
+                        {UINT(meshData.m_collisionVertices[v]), UINT(v)});
+            }
+            for (size_t i = 0; i < meshData.edges.size(); ++i) {
+                const Edge &e = meshData.edges[i];
+                const EdgeCut &cut = meshData.edgeCuts[i];
+                for (int cutVertex :
+                     {cut.cutVertexIndexUp, cut.cutVertexIndexDown}) {
+                    if (cutVertex == -1)
+                        continue;
+                    filterSources.push_back({UINT(cutVertex), e.index0});
+                    filterSources.push_back({UINT(cutVertex), e.index1});
+                }
+            }
+            InheritCollisionFilter(meshData, filterSources);
+
             meshData.indices.clear();
             meshData.edges.clear();
+            EdgeMap edgeMap;
+            edgeMap.Reset(meshData.triangles.size() * 3 / 2);
             for (auto &t : meshData.triangles) {
                 int vertexIndex0 = t.vertexIndices[0];
                 int vertexIndex1 = t.vertexIndices[1];
@@ -1466,16 +2886,19 @@ void BasicMeshGroup::LineCut(Vector2 line) {
                 meshData.indices.push_back(vertexIndex1);
                 meshData.indices.push_back(vertexIndex2);
 
-                t.edgeIndices[0] = 
-                    AddEdge(meshData, vertexIndex0, vertexIndex1);
-                t.edgeIndices[1] =
-                    AddEdge(meshData, vertexIndex1, vertexIndex2);
-                t.edgeIndices[2] =
-                    AddEdge(meshData, vertexIndex2, vertexIndex0);
+                t.edgeIndices[0] = GeometryGenerator::AddEdge(
+                    vertexIndex0, vertexIndex1, meshData, edgeMap);
+                t.edgeIndices[1] = GeometryGenerator::AddEdge(
+                    vertexIndex1, vertexIndex2, meshData, edgeMap);
+                t.edgeIndices[2] = GeometryGenerator::AddEdge(
+                    vertexIndex2, vertexIndex0, meshData, edgeMap);
             }
-            UpdateNormal();
-            InitParticles();
+            BuildSolverData(meshData); // island 재계산, 모두 깨어남
         }
+        // 모든 메쉬를 자른 뒤 한 번만
+        UpdateNormal();
+        InitParticles();
+        m_renderDirty = true;
     }
 
 void BasicMeshGroup::UpdateNormal()
@@ -1521,17 +2944,17 @@ void BasicMeshGroup::UpdateNormalLines(ComPtr<ID3D11Device> &device,
         std::vector<Vertex> normalVertices;
         std::vector<uint32_t> normalIndices;
 
-        //  ޽ normal  ϳ ġ
+        // 여러 메쉬의 normal 들을 하나로 합치기
         size_t offset = 0;
         for (const auto &mesh : m_meshes) {
             for (size_t i = 0; i < mesh->m_meshData.vertices.size(); i++) {
 
                 auto v = mesh->m_meshData.vertices[i];
 
-                v.texcoord.x = 0.0f; //  ǥ
+                v.texcoord.x = 0.0f; // 시작점 표시
                 normalVertices.push_back(v);
 
-                v.texcoord.x = 1.0f; //  ǥ
+                v.texcoord.x = 1.0f; // 끝점 표시
                 normalVertices.push_back(v);
 
                 normalIndices.push_back(uint32_t(2 * (i + offset)));
@@ -1549,6 +2972,9 @@ void BasicMeshGroup::UpdateNormalLines(ComPtr<ID3D11Device> &device,
     }
 
 void BasicMeshGroup::PrintParticleCount() {
-        std::cout << "Particle Count: " << m_meshes[0]->m_meshData.vertices.size() << std::endl;
+        const MeshData &meshData = m_meshes[0]->m_meshData;
+        std::cout << "Particle Count: "
+                  << meshData.vertices.size() - meshData.freeParticles.size()
+                  << std::endl;
     }
 } // namespace jhm
\ No newline at end of file
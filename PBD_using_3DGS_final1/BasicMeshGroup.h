@@ -1,14 +1,45 @@
 ﻿#pragma once
 
 #include "BasicConstantData.h"
+#include "ColliderSet.h"
 #include "Mesh.h"
 #include "MeshData.h"
 #include "Ray.h"
 #include "Hit.h"
 #include "D3D11Utils.h"
+#include "DistanceKernel.h"
+
+#include <array>
 
 namespace jhm {
 
+// ProjectDistanceConstraints 방식
+enum PBDSolverType {
+    PBD_SOLVER_GAUSS_SEIDEL = 0,         // edge 순서대로 직렬
+    PBD_SOLVER_COLORED_GAUSS_SEIDEL = 1, // color batch 단위로 병렬
+    PBD_SOLVER_JACOBI = 2, // vertex별로 누적한 보정값의 평균을 한 번에 적용
+    // vertex 구간 block마다 내부 edge를 여러 번 반복 (block끼리 병렬)한 뒤
+    // block 경계 edge를 직렬로 한 번
+    PBD_SOLVER_BLOCKED_GAUSS_SEIDEL = 3,
+};
+
+// computeVolumeConstraintScaling의 부피 / gradient 계산 방식
+enum VolumeTrackingMode {
+    VOLUME_TRACKING_FULL = 0,        // 매번 모든 triangle 다시 계산
+    VOLUME_TRACKING_INCREMENTAL = 1, // 위치가 바뀐 vertex 주변만 갱신
+    // 증분 갱신 결과를 전체 계산과 비교해 m_volumeDrift에 기록
+    VOLUME_TRACKING_VERIFY = 2,
+};
+
+// 병렬 sampling 중인 edge / triangle 하나가 쓰는 vertex
+// reserved[0 ~ numReserved)를 차례로 꺼내 씀 (list slot도 확보되어 있음)
+struct ParticleSlots {
+    const UINT *reserved = nullptr;
+    UINT numReserved = 0;
+    UINT numUsed = 0;
+    std::vector<UINT> *released = nullptr; // 반납할 vertex
+};
+
 class BasicMeshGroup {
   public:
     void Initialize(ComPtr<ID3D11Device> &device, const std::string &basePath,
@@ -17,6 +48,9 @@ class BasicMeshGroup {
     void Initialize(ComPtr<ID3D11Device> &device,
                     const std::vector<MeshData> &meshes);
 
+    // GPU 리소스 없이 시뮬레이션 데이터만 초기화 (benchmark 용)
+    void InitializeSimulation(const std::vector<MeshData> &meshes);
+
     void UpdateConstantBuffers(ComPtr<ID3D11Device> &device,
                                ComPtr<ID3D11DeviceContext> &context);
 
@@ -39,16 +73,104 @@ class BasicMeshGroup {
     // PBD Simulation 함수
     void InitParticles();
     void UpdateParticles();
-    void EdgeSampling(MeshData &meshData, Edge &e, float d);
-    void InnerSampling(MeshData &meshData, Triangle &t, float d);
+    // UpdateParticles: 개수 구간을 m_resampleHysteresis 이상 벗어난 edge,
+    // triangle만 후보로 모아 왜곡이 큰 순서로 m_resampleBudget개까지 처리
+    // particle 개수 / 배치가 바뀐 edge, triangle만 barycentric 좌표를 다시
+    // 계산 (위치는 EvaluateParticles에서)
+    // slots == nullptr: vertex 할당 / 반납을 바로 함
+    // 아니면 병렬 구간: 늘어나는 particle은 slots에 미리 할당해 둔 vertex를
+    // 쓰고 반납할 vertex는 slots->released에 모음
+    void EdgeSampling(MeshData &meshData, UINT edgeIndex, float d,
+                      ParticleSlots *slots = nullptr);
+    void InnerSampling(MeshData &meshData, UINT triangleIndex, float d,
+                       ParticleSlots *slots = nullptr);
+    // meshData.resampleQueue의 edge / triangle을 병렬로 sampling
+    // 늘어나는 수만큼 큐 순서대로 vertex와 list slot을 먼저 할당 (prefix sum)
+    void ResampleQueued(MeshData &meshData, float d);
+    // boundary particle vertex 할당 / 반납. 반납한 vertex는 그리기
+    // 목록(indices)에서 빠지고 다음 할당에서 재사용
+    // 새 particle은 triangle 꼭짓점 가중치 u, v, 1 - u - v의 점
+    // slots가 있으면 미리 할당해 둔 vertex에 좌표만 설정 (병렬 구간용)
+    UINT AllocParticle(MeshData &meshData, UINT triangle, float u, float v,
+                       ParticleSlots *slots = nullptr);
+    void FreeParticle(MeshData &meshData, UINT index);
+    // 살아 있는 boundary particle을 triangle 순서(공간 순서)로 mesh vertex
+    // 뒤에 빈틈 없이 모으고 particle list와 indices의 번호를 고침
+    // 줄어든 메모리(byte) 반환
+    size_t CompactParticles(MeshData &meshData);
+    // force면 모든 메쉬, 아니면 fragmentation이 m_compactionThreshold를 넘은
+    // 메쉬만 compaction하고 m_compactionBytes / m_compactionMs에 기록
+    void CompactParticles(bool force = true);
+    // 반납되어 비어 있는 particle vertex slot의 비율
+    static float GetParticleFragmentation(const MeshData &meshData);
+    // 모든 particle의 위치 / normal / texcoord를 barycentric 좌표와 mesh
+    // vertex로 계산 (SIMD batch)
+    void EvaluateParticles(MeshData &meshData);
     
+    // 한 프레임: substep마다 외력 -> constraint 반복 -> 적분
+    void Simulate(float dt);
+    // 메쉬 하나의 constraint 반복 (early termination 포함)
+    void SolveConstraints(MeshData &meshData);
+    void ResetLambdas();
+    // Chebyshev: 반복 전 예측 위치를 q(k-1) = q(k)로 저장
+    void ResetChebyshev(MeshData &meshData);
+    // q(k+1) = omega * (q^ - q(k-1)) + q(k-1), q^는 이번 반복의 투영 결과
+    // 이번 반복의 위치 변화량 |q^ - q(k)|^2 반환
+    double ApplyChebyshev(MeshData &meshData, float omega);
     void ApplyExtForces(float dt);
     void ProjectDistanceConstraints(); 
-    void ProjectDistanceConstraint(MeshData &meshData, Edge &e);
+    void ProjectDistanceConstraints(MeshData &meshData);
+    // lambda != nullptr 이면 XPBD, 보정 전 constraint 값 C 반환
+    float ProjectDistanceConstraint(MeshData &meshData, Edge &e,
+                                    float *lambda = nullptr);
+    StrainAccumulator ProjectDistanceConstraintsColored(MeshData &meshData);
+    StrainAccumulator ProjectDistanceConstraintsBlocked(MeshData &meshData);
+    void BuildSolverData(MeshData &meshData);
+    void BuildEdgeColoring(MeshData &meshData);
+    void BuildConstraintBlocks(MeshData &meshData);
+    void BuildAdjacency(MeshData &meshData);
+    void BuildIslands(MeshData &meshData);
+    // 처음 한 번 로드한 위치로 가까운 쌍을 찾고, 그 뒤로는 edge만 추가
+    void BuildCollisionFilter(MeshData &meshData);
+    // LineCut으로 생긴 vertex에 (새 vertex, 원래 vertex)의 filter 쌍을 복사
+    void InheritCollisionFilter(
+        MeshData &meshData,
+        const std::vector<std::pair<UINT, UINT>> &sources);
+    // substep마다 예측 위치로 spatial hash를 만들고 가까운 particle 쌍 수집
+    void FindSelfContacts(MeshData &meshData);
+    void ProjectSelfContacts(MeshData &meshData);
+    float GetSelfCollisionDistance(const MeshData &meshData) const;
+    // substep마다 예측 위치의 AABB와 겹치는 collider만 남김 (broadphase)
+    void FindColliderCandidates(MeshData &meshData);
+    void ProjectColliderContacts(MeshData &meshData);
+    StrainAccumulator ProjectDistanceConstraintsJacobi(MeshData &meshData);
     void SolveOverpressureConstraints();
+    void SolveOverpressureConstraints(MeshData &meshData);
     float computeVolumeConstraintScaling(MeshData &meshData);
+    // 모든 triangle의 부피와 vertex별 gradient (증분 추적 캐시도 채움)
+    void ComputeVolumeFull(MeshData &meshData, double &volume,
+                           double &gradSum);
+    // 캐시와 달라진 vertex 주변만 갱신. 캐시가 없거나, refresh 주기가
+    // 되었거나, 바뀐 vertex가 많으면 false (전체 계산 필요)
+    bool UpdateVolumeIncremental(MeshData &meshData, double &volume,
+                                 double &gradSum);
+    // 캐시를 건드리지 않고 다시 계산한 값과의 상대 오차 (VERIFY)
+    double MeasureVolumeDrift(const MeshData &meshData, double volume,
+                              double gradSum) const;
     void solveOverpressureConstraint(MeshData &meshData, Triangle &t, float scaling);
+    void SolveOverpressureConstraintsJacobi(MeshData &meshData, float scaling);
     void Integrate(float dt);
+    // 시뮬레이션 위치를 렌더링용 Vertex에 복사 (UpdateNormal, 업로드 전)
+    void GatherParticlePositions();
+
+    // Sleep: 운동 에너지가 m_sleepFrames 프레임 동안 m_sleepEnergy 아래면
+    // island를 재우고, 잠든 island의 particle은 위치를 고정한다.
+    // 메쉬의 모든 island가 잠들면 그 메쉬는 시뮬레이션하지 않는다.
+    void UpdateSleepState(MeshData &meshData);
+    void WakeAll();
+    void WakeIsland(MeshData &meshData, int vertexIndex);
+    bool IsAsleep(const MeshData &meshData) const;
+    void GetIslandCount(int &numSleeping, int &numIslands) const;
     
     void UpdateNormal();
     void UpdateNormalLines(ComPtr<ID3D11Device> &device,
@@ -60,15 +182,22 @@ class BasicMeshGroup {
     void MouseDrag(int x, int y, int screenWidth, int screenHeight);
 
     // Tearing
-    void CheckCut(MeshData &meshData, Edge &e, Vector2 line);
+    void CheckCut(MeshData &meshData, const Edge &e, EdgeCut &cut,
+                  Vector2 line);
     void CutEdge(MeshData &meshData, Triangle &t, Vector2 line);
     void CutTwoEdge();
     void CutVertex(MeshData &meshData, Triangle &t, Vector2 line);
-    int AddEdge(MeshData &meshData, int index0, int index1);
     void LineCut(Vector2 line);
 
     // Print Particle Count
     void PrintParticleCount();
+
+    MeshData &GetMeshData(int index) { return m_meshes[index]->m_meshData; }
+    // 메쉬 중 가장 많은 multigrid level 수 (원본 제외)
+    int GetMultigridLevelCount() const;
+    int GetMeshCount() const { return int(m_meshes.size()); }
+    // 모든 메쉬 중 가장 큰 residual / 반복 횟수
+    SolverResidual GetResidual() const;
   public:
     // ExampleApp::Update()에서 접근
     BasicVertexConstantData m_basicVertexConstantData;
@@ -86,13 +215,91 @@ class BasicMeshGroup {
 
     // Volume
     float m_volumePressure = 1.0f;
+    int m_volumeTracking = VOLUME_TRACKING_INCREMENTAL;
+    int m_volumeRefreshInterval = 100; // 증분 갱신 횟수마다 전체 재계산
+    float m_volumeDirtyRatio = 0.25f;  // 바뀐 vertex 비율이 넘으면 전체 계산
+    double m_volumeDrift = 0.0; // VERIFY: 마지막 비교의 상대 오차
 
     // Particle 거리 
     float m_particle_distance = 0.04f;
 
+    // Particle compaction: UpdateParticles 뒤 fragmentation이 이 값을 넘으면
+    // 자동으로 (0이면 하지 않음). 마지막 compaction의 결과
+    float m_compactionThreshold = 0.3f;
+    int m_numCompactions = 0;
+    size_t m_compactionBytes = 0; // 줄어든 메모리
+    double m_compactionMs = 0.0;
+
+    // Resampling: 길이 / 간격이 개수 구간 [n, n + 1)을 이만큼(간격 단위)
+    // 벗어나야 다시 sampling (0이면 바로). 프레임당 최대 개수 (0이면 무제한)
+    float m_resampleHysteresis = 0.25f;
+    int m_resampleBudget = 4096;
+    int m_numResamples = 0;         // 마지막 UpdateParticles에서 처리한 수
+    int m_numDeferredResamples = 0; // 예산을 넘어 다음 프레임으로 미룬 수
+
     // Gaussian scale
     float m_gaussian_scaling = 0.76f;
 
+    // Solver
+    int m_solverType = PBD_SOLVER_GAUSS_SEIDEL;
+    int m_numThreads = 0; // 0이면 ThreadPool의 전체 스레드 사용
+    float m_jacobiOmega = 1.5f; // Jacobi over-relaxation
+    int m_distanceKernel = DISTANCE_KERNEL_AUTO; // Colored GS의 SIMD kernel
+    int m_particleKernel = DISTANCE_KERNEL_AUTO; // EvaluateParticles의 kernel
+    int m_blockIterations = 3; // Blocked GS: block마다 내부 edge 반복 횟수
+
+    // Substep scheduler: 프레임당 m_numSubsteps x m_numIterations
+    int m_numSubsteps = 1;
+    int m_numIterations = 5; // early termination 시 최대 반복 횟수
+    bool m_earlyTermination = false;
+    float m_tolerance = 1e-3f; // 메쉬별 residual (SolverResidual::Value) 기준
+    float m_substepDt = 1.0f / 60.0f;
+    float m_damping = 0.59f; // 1/60초 동안 남는 속도 비율
+
+    // PBD: 반복마다 오차의 stiffness 비율만큼 보정 (반복 횟수, dt에 의존)
+    // XPBD: compliance(= 1 / stiffness)와 Lagrange multiplier로 보정
+    bool m_useXPBD = false;
+    float m_distanceStiffness = 0.9f;
+    float m_volumeStiffness = 1.0f;
+    float m_distanceCompliance = 0.0f;
+    float m_volumeCompliance = 0.0f;
+
+    // Hierarchical PBD: 반복마다 원본 sweep 전에 coarse level V-cycle
+    bool m_useMultigrid = false;
+    int m_multigridCoarseIterations = 2; // level마다 Gauss-Seidel 횟수
+
+    // Self collision: particle 사이 최소 거리 = scale * 평균 edge 길이
+    bool m_useSelfCollision = false;
+    float m_selfCollisionScale = 0.5f;
+    // 마지막 프레임의 broadphase(hash 생성) / narrowphase(쌍 검사) 시간 (ms,
+    // 모든 메쉬와 substep 합)과 contact 수
+    double m_broadphaseMs = 0.0;
+    double m_narrowphaseMs = 0.0;
+    int m_numContacts = 0;
+
+    // Static collider: SimulationScene::Register에서 scene의 collider 연결
+    const ColliderSet *m_colliders = nullptr;
+    float m_colliderMargin = 0.01f; // collider 표면과의 최소 거리
+    float m_gravity = 0.0f;         // 아래(-y) 방향 중력 가속도
+    // 마지막 프레임의 broadphase를 통과한 collider 수와 contact 수, 소요 시간
+    // (ms, 모든 메쉬와 substep 합)
+    int m_numColliderCandidates = 0;
+    int m_numColliderContacts = 0;
+    double m_colliderMs = 0.0;
+
+    // Chebyshev semi-iterative 가속 (constraint 반복 사이의 위치 외삽)
+    bool m_useChebyshev = false;
+    int m_chebyshevWarmup = 3;   // 가속 없이 수행하는 처음 반복 횟수
+    float m_chebyshevRho = 0.0f; // spectral radius, 0이면 warm-up에서 추정
+
+    // Sleep
+    bool m_useSleep = true;
+    float m_sleepEnergy = 1e-6f; // vertex당 평균 운동 에너지 기준
+    int m_sleepFrames = 30;
+    // 시뮬레이션 결과가 바뀌어서 normal 계산, particle resampling, 버퍼
+    // 업로드가 필요함 (ExampleApp::Update에서 처리 후 false)
+    bool m_renderDirty = true;
+
     // Mouse
     MeshData* m_dragMeshData = nullptr;
     Triangle m_dragTriangle;
@@ -104,10 +311,17 @@ class BasicMeshGroup {
     bool m_LineCollision = false;
 
     bool m_useTexture = false;
+  private:
+    // 바뀌면 잠든 island를 모두 깨우는 파라미터 (매 프레임 비교하므로 고정 크기)
+    using WakeParameters = std::array<float, 27>;
+    WakeParameters GetWakeParameters() const;
+
   private:
     // 메쉬 그리기
     std::vector<shared_ptr<Mesh>> m_meshes;
 
+    WakeParameters m_wakeParameters = {};
+
     ComPtr<ID3D11VertexShader> m_basicVertexShader;
     ComPtr<ID3D11GeometryShader> m_basicGeometryShader;
     ComPtr<ID3D11PixelShader> m_basicPixelShader;
@@ -0,0 +1,526 @@
+﻿#include "ColliderSet.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "CpuFeatures.h"
+
+#if PBD_X86
+#include <immintrin.h>
+#endif
+
+namespace jhm {
+
+namespace {
+
+// Project에서 SDF를 한 번에 Sample하는 particle 수 (stack 버퍼 크기)
+const int SDF_BATCH_SIZE = 256;
+// 삼각형 주변 몇 cell까지 정확한 거리를 계산할지
+const int SDF_EXACT_BAND = 1;
+// 길이가 이보다 짧은 normal은 방향을 정할 수 없으므로 건너뜀
+const float MIN_LENGTH_SQUARED = 1e-12f;
+
+// 점 p에서 삼각형 abc까지의 거리 (Real-Time Collision Detection 5.1.5)
+float PointTriangleDistance(const Vector3 &p, const Vector3 &a,
+                            const Vector3 &b, const Vector3 &c) {
+    Vector3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = ab.Dot(ap), d2 = ac.Dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f)
+        return (p - a).Length();
+
+    Vector3 bp = p - b;
+    float d3 = ab.Dot(bp), d4 = ac.Dot(bp);
+    if (d3 >= 0.0f && d4 <= d3)
+        return (p - b).Length();
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        return (p - (a + ab * (d1 / (d1 - d3)))).Length();
+
+    Vector3 cp = p - c;
+    float d5 = ab.Dot(cp), d6 = ac.Dot(cp);
+    if (d6 >= 0.0f && d5 <= d6)
+        return (p - c).Length();
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        return (p - (a + ac * (d2 / (d2 - d6)))).Length();
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        return (p - (b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)))))
+            .Length();
+
+    float denom = 1.0f / (va + vb + vc);
+    return (p - (a + ab * (vb * denom) + ac * (vc * denom))).Length();
+}
+
+// 2D edge function, top-left rule로 공유 edge 위의 점을 한 삼각형에만 포함
+bool InsideEdge(float ay, float az, float by, float bz, float py, float pz) {
+    float e = (by - ay) * (pz - az) - (bz - az) * (py - ay);
+    if (e != 0.0f)
+        return e > 0.0f;
+    return bz < az || (bz == az && by > ay);
+}
+
+inline float Clamp(float v, float lo, float hi) {
+    return std::min(std::max(v, lo), hi);
+}
+
+} // namespace
+
+void SdfGrid::Bake(const MeshData &meshData, float cellSize, float padding) {
+    const auto &vertices = meshData.vertices;
+    const auto &indices = meshData.indices;
+
+    ColliderAabb bounds;
+    for (const auto &v : vertices) {
+        bounds.min = Vector3::Min(bounds.min, v.position);
+        bounds.max = Vector3::Max(bounds.max, v.position);
+    }
+    m_cellSize = cellSize;
+    m_invCellSize = 1.0f / cellSize;
+    m_origin = bounds.min - Vector3(padding);
+    Vector3 size = bounds.max - bounds.min + Vector3(2.0f * padding);
+    m_nx = std::max(2, int(std::ceil(size.x * m_invCellSize)) + 1);
+    m_ny = std::max(2, int(std::ceil(size.y * m_invCellSize)) + 1);
+    m_nz = std::max(2, int(std::ceil(size.z * m_invCellSize)) + 1);
+
+    const int numCells = m_nx * m_ny * m_nz;
+    const float far = float(m_nx + m_ny + m_nz) * cellSize;
+    m_distance.assign(numCells, far);
+    std::vector<int> closest(numCells, -1);  // 가장 가까운 삼각형
+    std::vector<int> crossings(numCells, 0); // x축 ray가 지나는 표면 수
+
+    auto index = [&](int i, int j, int k) {
+        return (k * m_ny + j) * m_nx + i;
+    };
+    auto point = [&](int i, int j, int k) {
+        return m_origin + Vector3(float(i), float(j), float(k)) * cellSize;
+    };
+    auto clampIndex = [](int v, int n) {
+        return std::min(std::max(v, 0), n - 1);
+    };
+
+    // 1) 삼각형 주변 격자 점의 정확한 거리, x축 ray 교차 기록
+    const int numTriangles = int(indices.size() / 3);
+    for (int t = 0; t < numTriangles; ++t) {
+        const Vector3 &a = vertices[indices[t * 3 + 0]].position;
+        const Vector3 &b = vertices[indices[t * 3 + 1]].position;
+        const Vector3 &c = vertices[indices[t * 3 + 2]].position;
+        Vector3 lo = (Vector3::Min(a, Vector3::Min(b, c)) - m_origin) *
+                     m_invCellSize;
+        Vector3 hi = (Vector3::Max(a, Vector3::Max(b, c)) - m_origin) *
+                     m_invCellSize;
+
+        int i0 = clampIndex(int(std::floor(lo.x)) - SDF_EXACT_BAND, m_nx);
+        int j0 = clampIndex(int(std::floor(lo.y)) - SDF_EXACT_BAND, m_ny);
+        int k0 = clampIndex(int(std::floor(lo.z)) - SDF_EXACT_BAND, m_nz);
+        int i1 = clampIndex(int(std::ceil(hi.x)) + SDF_EXACT_BAND, m_nx);
+        int j1 = clampIndex(int(std::ceil(hi.y)) + SDF_EXACT_BAND, m_ny);
+        int k1 = clampIndex(int(std::ceil(hi.z)) + SDF_EXACT_BAND, m_nz);
+        for (int k = k0; k <= k1; ++k)
+            for (int j = j0; j <= j1; ++j)
+                for (int i = i0; i <= i1; ++i) {
+                    float d = PointTriangleDistance(point(i, j, k), a, b, c);
+                    int n = index(i, j, k);
+                    if (d < m_distance[n]) {
+                        m_distance[n] = d;
+                        closest[n] = t;
+                    }
+                }
+
+        // yz 평면에 투영한 삼각형 안의 격자 행 (j, k)
+        // 반시계 방향으로 맞춘 뒤 top-left rule을 쓰면 표면을 관통하는 공유
+        // edge 위의 행은 정확히 한 번 센다.
+        Vector3 p0 = a, p1 = b, p2 = c;
+        float area =
+            (p1.y - p0.y) * (p2.z - p0.z) - (p1.z - p0.z) * (p2.y - p0.y);
+        if (area == 0.0f)
+            continue;
+        if (area < 0.0f)
+            std::swap(p1, p2);
+        area = std::fabs(area);
+        for (int k = clampIndex(int(std::ceil(lo.z)), m_nz);
+             k <= clampIndex(int(std::floor(hi.z)), m_nz); ++k) {
+            for (int j = clampIndex(int(std::ceil(lo.y)), m_ny);
+                 j <= clampIndex(int(std::floor(hi.y)), m_ny); ++j) {
+                Vector3 q = point(0, j, k);
+                if (!InsideEdge(p0.y, p0.z, p1.y, p1.z, q.y, q.z) ||
+                    !InsideEdge(p1.y, p1.z, p2.y, p2.z, q.y, q.z) ||
+                    !InsideEdge(p2.y, p2.z, p0.y, p0.z, q.y, q.z))
+                    continue;
+
+                // 무게중심 좌표로 교차점의 x
+                float w0 = (p1.y - q.y) * (p2.z - q.z) -
+                           (p1.z - q.z) * (p2.y - q.y);
+                float w1 = (p2.y - q.y) * (p0.z - q.z) -
+                           (p2.z - q.z) * (p0.y - q.y);
+                float w2 = area - w0 - w1;
+                float x = (w0 * p0.x + w1 * p1.x + w2 * p2.x) / area;
+                int i = int(std::ceil((x - m_origin.x) * m_invCellSize));
+                if (i < m_nx)
+                    ++crossings[index(std::max(i, 0), j, k)];
+            }
+        }
+    }
+
+    // 2) fast sweeping: 이웃의 가장 가까운 삼각형으로 거리 갱신 (8방향 x 2)
+    auto update = [&](int i, int j, int k, int ni, int nj, int nk) {
+        int t = closest[index(ni, nj, nk)];
+        if (t < 0)
+            return;
+        int n = index(i, j, k);
+        float d = PointTriangleDistance(
+            point(i, j, k), vertices[indices[t * 3 + 0]].position,
+            vertices[indices[t * 3 + 1]].position,
+            vertices[indices[t * 3 + 2]].position);
+        if (d < m_distance[n]) {
+            m_distance[n] = d;
+            closest[n] = t;
+        }
+    };
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int dir = 0; dir < 8; ++dir) {
+            int di = dir & 1 ? -1 : 1;
+            int dj = dir & 2 ? -1 : 1;
+            int dk = dir & 4 ? -1 : 1;
+            for (int k = dk > 0 ? 1 : m_nz - 2; k >= 0 && k < m_nz; k += dk)
+                for (int j = dj > 0 ? 1 : m_ny - 2; j >= 0 && j < m_ny; j += dj)
+                    for (int i = di > 0 ? 1 : m_nx - 2; i >= 0 && i < m_nx;
+                         i += di) {
+                        update(i, j, k, i - di, j, k);
+                        update(i, j, k, i, j - dj, k);
+                        update(i, j, k, i, j, k - dk);
+                        update(i, j, k, i - di, j - dj, k);
+                        update(i, j, k, i - di, j, k - dk);
+                        update(i, j, k, i, j - dj, k - dk);
+                        update(i, j, k, i - di, j - dj, k - dk);
+                    }
+        }
+    }
+
+    // 3) 행마다 교차 수를 누적해서 홀수면 안쪽
+    for (int k = 0; k < m_nz; ++k)
+        for (int j = 0; j < m_ny; ++j) {
+            int count = 0;
+            for (int i = 0; i < m_nx; ++i) {
+                count += crossings[index(i, j, k)];
+                if (count % 2 == 1)
+                    m_distance[index(i, j, k)] = -m_distance[index(i, j, k)];
+            }
+        }
+}
+
+ColliderAabb SdfGrid::GetAabb() const {
+    ColliderAabb aabb;
+    aabb.min = m_origin;
+    aabb.max = m_origin + Vector3(float(m_nx - 1), float(m_ny - 1),
+                                  float(m_nz - 1)) *
+                              m_cellSize;
+    return aabb;
+}
+
+void SdfGrid::Sample(const float *x, const float *y, const float *z,
+                     int count, float *distance, float *gradX, float *gradY,
+                     float *gradZ) const {
+    int begin = 0;
+#if PBD_X86
+    if (CpuFeatures::Get().avx2) {
+        begin = count / 8 * 8;
+        SampleAvx2(x, y, z, 0, begin, distance, gradX, gradY, gradZ);
+    }
+#endif
+    SampleScalar(x, y, z, begin, count, distance, gradX, gradY, gradZ);
+}
+
+// 격자 좌표 f를 [0, n - 1]로 자르고 cell 번호 i in [0, n - 2]와 t = f - i
+void SdfGrid::SampleScalar(const float *x, const float *y, const float *z,
+                           int begin, int end, float *distance, float *gradX,
+                           float *gradY, float *gradZ) const {
+    const float *d = m_distance.data();
+    const int sy = m_nx, sz = m_nx * m_ny;
+    for (int n = begin; n < end; ++n) {
+        float fx = Clamp((x[n] - m_origin.x) * m_invCellSize, 0.0f,
+                         float(m_nx - 1));
+        float fy = Clamp((y[n] - m_origin.y) * m_invCellSize, 0.0f,
+                         float(m_ny - 1));
+        float fz = Clamp((z[n] - m_origin.z) * m_invCellSize, 0.0f,
+                         float(m_nz - 1));
+        int i = std::min(int(fx), m_nx - 2);
+        int j = std::min(int(fy), m_ny - 2);
+        int k = std::min(int(fz), m_nz - 2);
+        float tx = fx - float(i), ty = fy - float(j), tz = fz - float(k);
+
+        const float *c = d + k * sz + j * sy + i;
+        float c000 = c[0], c100 = c[1], c010 = c[sy], c110 = c[sy + 1];
+        float c001 = c[sz], c101 = c[sz + 1], c011 = c[sz + sy],
+              c111 = c[sz + sy + 1];
+
+        // x 방향 보간 -> y -> z
+        float c00 = c000 + tx * (c100 - c000);
+        float c10 = c010 + tx * (c110 - c010);
+        float c01 = c001 + tx * (c101 - c001);
+        float c11 = c011 + tx * (c111 - c011);
+        float c0 = c00 + ty * (c10 - c00);
+        float c1 = c01 + ty * (c11 - c01);
+        distance[n] = c0 + tz * (c1 - c0);
+
+        float ex0 = (c100 - c000) + ty * ((c110 - c010) - (c100 - c000));
+        float ex1 = (c101 - c001) + ty * ((c111 - c011) - (c101 - c001));
+        gradX[n] = (ex0 + tz * (ex1 - ex0)) * m_invCellSize;
+        gradY[n] = ((c10 - c00) + tz * ((c11 - c01) - (c10 - c00))) *
+                   m_invCellSize;
+        gradZ[n] = (c1 - c0) * m_invCellSize;
+    }
+}
+
+#if PBD_X86
+namespace {
+
+// a + t * (b - a)
+PBD_TARGET_AVX2 inline __m256 Lerp8(__m256 a, __m256 b, __m256 t) {
+    return _mm256_fmadd_ps(t, _mm256_sub_ps(b, a), a);
+}
+
+} // namespace
+
+PBD_TARGET_AVX2
+void SdfGrid::SampleAvx2(const float *x, const float *y, const float *z,
+                         int begin, int end, float *distance, float *gradX,
+                         float *gradY, float *gradZ) const {
+    const float *d = m_distance.data();
+    const __m256 origin[3] = {_mm256_set1_ps(m_origin.x),
+                              _mm256_set1_ps(m_origin.y),
+                              _mm256_set1_ps(m_origin.z)};
+    const __m256 upper[3] = {_mm256_set1_ps(float(m_nx - 1)),
+                             _mm256_set1_ps(float(m_ny - 1)),
+                             _mm256_set1_ps(float(m_nz - 1))};
+    const __m256i lastCell[3] = {_mm256_set1_epi32(m_nx - 2),
+                                 _mm256_set1_epi32(m_ny - 2),
+                                 _mm256_set1_epi32(m_nz - 2)};
+    const __m256 invCell = _mm256_set1_ps(m_invCellSize);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256i sy = _mm256_set1_epi32(m_nx);
+    const __m256i sz = _mm256_set1_epi32(m_nx * m_ny);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    for (int n = begin; n < end; n += 8) {
+        const float *p[3] = {x + n, y + n, z + n};
+        __m256 t[3];
+        __m256i cell[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            __m256 f = _mm256_mul_ps(
+                _mm256_sub_ps(_mm256_loadu_ps(p[axis]), origin[axis]),
+                invCell);
+            f = _mm256_min_ps(_mm256_max_ps(f, zero), upper[axis]);
+            cell[axis] = _mm256_min_epi32(_mm256_cvttps_epi32(f),
+                                          lastCell[axis]);
+            t[axis] = _mm256_sub_ps(f, _mm256_cvtepi32_ps(cell[axis]));
+        }
+
+        __m256i base = _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_mullo_epi32(cell[2], sz),
+                             _mm256_mullo_epi32(cell[1], sy)),
+            cell[0]);
+        __m256i baseY = _mm256_add_epi32(base, sy);
+        __m256i baseZ = _mm256_add_epi32(base, sz);
+        __m256i baseYZ = _mm256_add_epi32(baseY, sz);
+
+        __m256 c000 = _mm256_i32gather_ps(d, base, 4);
+        __m256 c100 = _mm256_i32gather_ps(d, _mm256_add_epi32(base, one), 4);
+        __m256 c010 = _mm256_i32gather_ps(d, baseY, 4);
+        __m256 c110 = _mm256_i32gather_ps(d, _mm256_add_epi32(baseY, one), 4);
+        __m256 c001 = _mm256_i32gather_ps(d, baseZ, 4);
+        __m256 c101 = _mm256_i32gather_ps(d, _mm256_add_epi32(baseZ, one), 4);
+        __m256 c011 = _mm256_i32gather_ps(d, baseYZ, 4);
+        __m256 c111 = _mm256_i32gather_ps(d, _mm256_add_epi32(baseYZ, one), 4);
+
+        __m256 c00 = Lerp8(c000, c100, t[0]);
+        __m256 c10 = Lerp8(c010, c110, t[0]);
+        __m256 c01 = Lerp8(c001, c101, t[0]);
+        __m256 c11 = Lerp8(c011, c111, t[0]);
+        __m256 c0 = Lerp8(c00, c10, t[1]);
+        __m256 c1 = Lerp8(c01, c11, t[1]);
+        _mm256_storeu_ps(distance + n, Lerp8(c0, c1, t[2]));
+
+        __m256 ex0 = Lerp8(_mm256_sub_ps(c100, c000),
+                          _mm256_sub_ps(c110, c010), t[1]);
+        __m256 ex1 = Lerp8(_mm256_sub_ps(c101, c001),
+                          _mm256_sub_ps(c111, c011), t[1]);
+        _mm256_storeu_ps(gradX + n,
+                         _mm256_mul_ps(Lerp8(ex0, ex1, t[2]), invCell));
+        __m256 ey =
+            Lerp8(_mm256_sub_ps(c10, c00), _mm256_sub_ps(c11, c01), t[2]);
+        _mm256_storeu_ps(gradY + n, _mm256_mul_ps(ey, invCell));
+        _mm256_storeu_ps(gradZ + n,
+                         _mm256_mul_ps(_mm256_sub_ps(c1, c0), invCell));
+    }
+}
+#else
+void SdfGrid::SampleAvx2(const float *x, const float *y, const float *z,
+                         int begin, int end, float *distance, float *gradX,
+                         float *gradY, float *gradZ) const {
+    SampleScalar(x, y, z, begin, end, distance, gradX, gradY, gradZ);
+}
+#endif
+
+int ColliderSet::AddPlane(const Vector3 &normal, float offset) {
+    Vector3 n = normal;
+    n.Normalize();
+    m_planes.push_back({n, offset});
+
+    // 평면의 AABB는 무한 (Query에서 따로 검사)
+    Collider collider{COLLIDER_PLANE, int(m_planes.size()) - 1, {}};
+    collider.aabb.min = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    collider.aabb.max = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+    m_colliders.push_back(collider);
+    return int(m_colliders.size()) - 1;
+}
+
+int ColliderSet::AddSphere(const Vector3 &center, float radius) {
+    m_spheres.push_back({center, radius});
+
+    Collider collider{COLLIDER_SPHERE, int(m_spheres.size()) - 1, {}};
+    collider.aabb.min = center - Vector3(radius);
+    collider.aabb.max = center + Vector3(radius);
+    m_colliders.push_back(collider);
+    return int(m_colliders.size()) - 1;
+}
+
+int ColliderSet::AddCapsule(const Vector3 &a, const Vector3 &b,
+                            float radius) {
+    m_capsules.push_back({a, b, radius});
+
+    Collider collider{COLLIDER_CAPSULE, int(m_capsules.size()) - 1, {}};
+    collider.aabb.min = Vector3::Min(a, b) - Vector3(radius);
+    collider.aabb.max = Vector3::Max(a, b) + Vector3(radius);
+    m_colliders.push_back(collider);
+    return int(m_colliders.size()) - 1;
+}
+
+int ColliderSet::AddSdf(SdfGrid &&grid) {
+    Collider collider{COLLIDER_SDF, int(m_sdfs.size()), grid.GetAabb()};
+    m_sdfs.push_back(std::move(grid));
+    m_colliders.push_back(collider);
+    return int(m_colliders.size()) - 1;
+}
+
+void ColliderSet::Clear() {
+    m_colliders.clear();
+    m_planes.clear();
+    m_spheres.clear();
+    m_capsules.clear();
+    m_sdfs.clear();
+}
+
+void ColliderSet::Query(const ColliderAabb &aabb,
+                        std::vector<int> &colliders) const {
+    colliders.clear();
+    for (int c = 0; c < GetCount(); ++c) {
+        const Collider &collider = m_colliders[c];
+        if (collider.type == COLLIDER_PLANE) {
+            // AABB에서 평면 안쪽으로 가장 깊은 꼭짓점이 평면 아래인지
+            const PlaneCollider &plane = m_planes[collider.index];
+            const Vector3 &n = plane.normal;
+            float lowest = n.x * (n.x > 0.0f ? aabb.min.x : aabb.max.x) +
+                           n.y * (n.y > 0.0f ? aabb.min.y : aabb.max.y) +
+                           n.z * (n.z > 0.0f ? aabb.min.z : aabb.max.z);
+            if (lowest <= plane.offset)
+                colliders.push_back(c);
+        } else if (collider.aabb.Overlaps(aabb)) {
+            colliders.push_back(c);
+        }
+    }
+}
+
+int ColliderSet::Project(ParticleState &particles,
+                         const std::vector<int> &colliders, float margin,
+                         int begin, int end) const {
+    ParticleState &p = particles;
+    int numContacts = 0;
+
+    // 표면 normal 방향으로 margin - distance 만큼 이동
+    auto push = [&](int i, float distance, float nx, float ny, float nz) {
+        if (distance >= margin || p.invMass[i] <= 0.0f)
+            return;
+        p.px[i] += (margin - distance) * nx;
+        p.py[i] += (margin - distance) * ny;
+        p.pz[i] += (margin - distance) * nz;
+        ++numContacts;
+    };
+
+    for (int c : colliders) {
+        const Collider &collider = m_colliders[c];
+
+        if (collider.type == COLLIDER_PLANE) {
+            const PlaneCollider &plane = m_planes[collider.index];
+            const Vector3 &n = plane.normal;
+            for (int i = begin; i < end; ++i)
+                push(i, n.x * p.px[i] + n.y * p.py[i] + n.z * p.pz[i] -
+                            plane.offset,
+                     n.x, n.y, n.z);
+        } else if (collider.type == COLLIDER_SPHERE ||
+                   collider.type == COLLIDER_CAPSULE) {
+            // 구는 길이 0인 capsule
+            Vector3 a, ab;
+            float radius;
+            if (collider.type == COLLIDER_SPHERE) {
+                const SphereCollider &sphere = m_spheres[collider.index];
+                a = sphere.center;
+                ab = Vector3(0.0f);
+                radius = sphere.radius;
+            } else {
+                const CapsuleCollider &capsule = m_capsules[collider.index];
+                a = capsule.a;
+                ab = capsule.b - capsule.a;
+                radius = capsule.radius;
+            }
+            float invLength2 =
+                ab.LengthSquared() > 0.0f ? 1.0f / ab.LengthSquared() : 0.0f;
+            const float reach = radius + margin;
+
+            for (int i = begin; i < end; ++i) {
+                float ax = p.px[i] - a.x, ay = p.py[i] - a.y,
+                      az = p.pz[i] - a.z;
+                float s = Clamp((ax * ab.x + ay * ab.y + az * ab.z) *
+                                    invLength2,
+                                0.0f, 1.0f);
+                float dx = ax - s * ab.x, dy = ay - s * ab.y,
+                      dz = az - s * ab.z;
+                float len2 = dx * dx + dy * dy + dz * dz;
+                if (len2 >= reach * reach || len2 <= MIN_LENGTH_SQUARED)
+                    continue;
+                float len = std::sqrt(len2);
+                push(i, len - radius, dx / len, dy / len, dz / len);
+            }
+        } else {
+            const SdfGrid &sdf = m_sdfs[collider.index];
+            alignas(64) float distance[SDF_BATCH_SIZE];
+            alignas(64) float gradX[SDF_BATCH_SIZE];
+            alignas(64) float gradY[SDF_BATCH_SIZE];
+            alignas(64) float gradZ[SDF_BATCH_SIZE];
+
+            for (int batch = begin; batch < end; batch += SDF_BATCH_SIZE) {
+                int count = std::min(SDF_BATCH_SIZE, end - batch);
+                sdf.Sample(p.px.data() + batch, p.py.data() + batch,
+                           p.pz.data() + batch, count, distance, gradX, gradY,
+                           gradZ);
+                for (int n = 0; n < count; ++n) {
+                    if (distance[n] >= margin)
+                        continue;
+                    float len2 = gradX[n] * gradX[n] + gradY[n] * gradY[n] +
+                                 gradZ[n] * gradZ[n];
+                    if (len2 <= MIN_LENGTH_SQUARED)
+                        continue;
+                    float inv = 1.0f / std::sqrt(len2);
+                    push(batch + n, distance[n], gradX[n] * inv,
+                         gradY[n] * inv, gradZ[n] * inv);
+                }
+            }
+        }
+    }
+    return numContacts;
+}
+
+} // namespace jhm
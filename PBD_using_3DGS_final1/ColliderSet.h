@@ -0,0 +1,122 @@
+﻿#pragma once
+
+#include <cfloat>
+#include <cstdint>
+#include <directxtk/SimpleMath.h>
+#include <vector>
+
+#include "MeshData.h"
+#include "ParticleState.h"
+
+namespace jhm {
+
+using DirectX::SimpleMath::Vector3;
+
+struct ColliderAabb {
+    Vector3 min = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vector3 max = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    bool Overlaps(const ColliderAabb &other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+};
+
+enum ColliderType {
+    COLLIDER_PLANE = 0,
+    COLLIDER_SPHERE = 1,
+    COLLIDER_CAPSULE = 2,
+    COLLIDER_SDF = 3,
+};
+
+// dot(normal, x) = offset 인 평면, normal 방향이 바깥 (normal은 단위 벡터)
+struct PlaneCollider {
+    Vector3 normal;
+    float offset;
+};
+
+struct SphereCollider {
+    Vector3 center;
+    float radius;
+};
+
+// 선분 a-b에서 radius 이내
+struct CapsuleCollider {
+    Vector3 a, b;
+    float radius;
+};
+
+// 격자 점마다 signed distance (안쪽이 음수)를 저장한 voxel grid
+// 격자 사이는 trilinear 보간, normal은 보간식의 gradient
+class SdfGrid {
+  public:
+    // 닫힌 삼각형 mesh(vertices, indices)에서 생성
+    // 표면 근처는 정확한 삼각형 거리, 나머지는 fast sweeping으로 채우고
+    // 부호는 x축 방향 ray의 교차 횟수(parity)로 정한다.
+    // padding: mesh AABB 바깥으로 늘릴 거리 (contact margin보다 커야 함)
+    void Bake(const MeshData &meshData, float cellSize, float padding);
+
+    // 위치 count개의 signed distance와 gradient를 한 번에 계산
+    // 격자 밖의 위치는 가장 가까운 경계 위치에서 계산 (padding 이상 떨어짐)
+    // AVX2를 지원하면 8개씩 gather로 처리
+    void Sample(const float *x, const float *y, const float *z, int count,
+                float *distance, float *gradX, float *gradY,
+                float *gradZ) const;
+
+    ColliderAabb GetAabb() const;
+    int GetCellCount() const { return m_nx * m_ny * m_nz; }
+    bool IsEmpty() const { return m_distance.empty(); }
+
+  private:
+    void SampleScalar(const float *x, const float *y, const float *z,
+                      int begin, int end, float *distance, float *gradX,
+                      float *gradY, float *gradZ) const;
+    void SampleAvx2(const float *x, const float *y, const float *z, int begin,
+                    int end, float *distance, float *gradX, float *gradY,
+                    float *gradZ) const;
+
+  private:
+    Vector3 m_origin; // 격자 점 (0, 0, 0)의 위치
+    float m_cellSize = 1.0f;
+    float m_invCellSize = 1.0f;
+    int m_nx = 0, m_ny = 0, m_nz = 0; // 격자 점 수
+    AlignedVector<float> m_distance;  // index = (k * m_ny + j) * m_nx + i
+};
+
+// 움직이지 않는 collider 모음 (SimulationScene이 소유, 모든 그룹이 공유)
+class ColliderSet {
+  public:
+    int AddPlane(const Vector3 &normal, float offset);
+    int AddSphere(const Vector3 &center, float radius);
+    int AddCapsule(const Vector3 &a, const Vector3 &b, float radius);
+    int AddSdf(SdfGrid &&grid);
+    void Clear();
+
+    int GetCount() const { return int(m_colliders.size()); }
+    bool IsEmpty() const { return m_colliders.empty(); }
+
+    // broadphase: aabb와 겹칠 수 있는 collider 번호를 colliders에 저장
+    void Query(const ColliderAabb &aabb, std::vector<int> &colliders) const;
+
+    // particle [begin, end)의 예측 위치를 collider 표면에서 margin 밖으로
+    // 밀어냄 (부등식 constraint). invMass가 0인 particle은 그대로.
+    // 보정한 contact 수 반환
+    int Project(ParticleState &particles, const std::vector<int> &colliders,
+                float margin, int begin, int end) const;
+
+  private:
+    struct Collider {
+        ColliderType type;
+        int index; // type별 배열의 번호
+        ColliderAabb aabb;
+    };
+
+    std::vector<Collider> m_colliders;
+    std::vector<PlaneCollider> m_planes;
+    std::vector<SphereCollider> m_spheres;
+    std::vector<CapsuleCollider> m_capsules;
+    std::vector<SdfGrid> m_sdfs;
+};
+
+} // namespace jhm
@@ -0,0 +1,75 @@
+﻿#include "CpuFeatures.h"
+
+#if PBD_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace jhm {
+
+namespace {
+
+#if PBD_X86
+void Cpuid(int info[4], int leaf, int subleaf) {
+#ifdef _MSC_VER
+    __cpuidex(info, leaf, subleaf);
+#else
+    unsigned int a, b, c, d;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    info[0] = int(a);
+    info[1] = int(b);
+    info[2] = int(c);
+    info[3] = int(d);
+#endif
+}
+
+unsigned long long Xgetbv() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+CpuFeatures Detect() {
+    CpuFeatures features;
+
+    int info[4];
+    Cpuid(info, 0, 0);
+    const int maxLeaf = info[0];
+    if (maxLeaf < 1)
+        return features;
+
+    Cpuid(info, 1, 0);
+    features.sse41 = (info[2] & (1 << 19)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+
+    // OS가 XMM/YMM 상태를 저장해줘야 AVX 사용 가능
+    const bool ymmEnabled = osxsave && (Xgetbv() & 0x6) == 0x6;
+
+    if (maxLeaf >= 7) {
+        Cpuid(info, 7, 0);
+        const bool avx2 = (info[1] & (1 << 5)) != 0;
+        features.avx2 = avx && avx2 && fma && ymmEnabled;
+    }
+    return features;
+}
+#else
+CpuFeatures Detect() { return CpuFeatures(); }
+#endif
+
+} // namespace
+
+const CpuFeatures &CpuFeatures::Get() {
+    static const CpuFeatures features = Detect();
+    return features;
+}
+
+} // namespace jhm
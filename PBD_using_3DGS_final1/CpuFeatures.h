@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) ||             \
+    defined(__i386__)
+#define PBD_X86 1
+#else
+#define PBD_X86 0
+#endif
+
+// MSVC는 /arch 옵션 없이도 intrinsic을 쓸 수 있지만 GCC/Clang은 함수 단위로
+// target을 지정해야 한다.
+#if PBD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define PBD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define PBD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define PBD_TARGET_SSE41
+#define PBD_TARGET_AVX2
+#endif
+
+namespace jhm {
+
+// 실행 중인 CPU가 지원하는 명령어 집합 (cpuid로 한 번만 검사)
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false; // AVX2 + FMA + OS의 YMM 레지스터 저장 지원
+
+    static const CpuFeatures &Get();
+};
+
+} // namespace jhm
@@ -1,6 +1,6 @@
 #include "D3D11Utils.h"
 
-#include <directxtk/DDSTextureLoader.h> // ť   ʿ
+#include <directxtk/DDSTextureLoader.h> // 큐브맵 읽을 때 필요
 #include <dxgi.h>                       // DXGIFactory
 #include <dxgi1_4.h>                    // DXGIFactory4
 #include <iostream>
@@ -15,12 +15,12 @@ using namespace DirectX;
 
 void CheckResult(HRESULT hr, ID3DBlob *errorBlob) {
     if (FAILED(hr)) {
-        //   
+        // 파일이 없을 경우
         if ((hr & D3D11_ERROR_FILE_NOT_FOUND) != 0) {
             cout << "File not found." << endl;
         }
 
-        //  ޽  
+        // 에러 메시지가 있으면 출력
         if (errorBlob) {
             cout << "Shader compile error\n"
                  << (char *)errorBlob->GetBufferPointer() << endl;
@@ -77,8 +77,8 @@ void D3D11Utils::CreateVertexShaderAndInputLayout(
     compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
 
-    // ̴  ̸ "main" Լ 
-    // D3D_COMPILE_STANDARD_FILE_INCLUDE ߰: ̴ include 
+    // 쉐이더의 시작점의 이름이 "main"인 함수로 지정
+    // D3D_COMPILE_STANDARD_FILE_INCLUDE 추가: 쉐이더에서 include 사용
     HRESULT hr = D3DCompileFromFile(
         filename.c_str(), 0, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main",
         "vs_5_0", compileFlags, 0, &shaderBlob, &errorBlob);
@@ -127,8 +127,8 @@ void D3D11Utils::CreatePixelShader(ComPtr<ID3D11Device> &device,
     compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
 
-    // ̴  ̸ "main" Լ 
-    // D3D_COMPILE_STANDARD_FILE_INCLUDE ߰: ̴ include 
+    // 쉐이더의 시작점의 이름이 "main"인 함수로 지정
+    // D3D_COMPILE_STANDARD_FILE_INCLUDE 추가: 쉐이더에서 include 사용
     HRESULT hr = D3DCompileFromFile(
         filename.c_str(), 0, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main",
         "ps_5_0", compileFlags, 0, &shaderBlob, &errorBlob);
@@ -143,7 +143,7 @@ void D3D11Utils::CreateIndexBuffer(ComPtr<ID3D11Device> &device,
                                    const std::vector<uint32_t> &indices,
                                    ComPtr<ID3D11Buffer> &indexBuffer) {
     D3D11_BUFFER_DESC bufferDesc = {};
-    bufferDesc.Usage = D3D11_USAGE_IMMUTABLE; // ʱȭ  X
+    bufferDesc.Usage = D3D11_USAGE_IMMUTABLE; // 초기화 후 변경X
     bufferDesc.ByteWidth = UINT(sizeof(uint32_t) * indices.size());
     bufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
     bufferDesc.CPUAccessFlags = 0; // 0 if no CPU access is necessary.
@@ -170,7 +170,7 @@ void D3D11Utils::CreateTexture(
 
     // assert(channels == 4);
 
-    // 4äη  
+    // 4채널로 만들어서 복사
     std::vector<uint8_t> image;
     image.resize(width * height * 4);
     for (size_t i = 0; i < width * height; i++) {
@@ -211,7 +211,7 @@ void D3D11Utils::CreateCubemapTexture(
     auto hr = CreateDDSTextureFromFileEx(
         device.Get(), filename, 0, D3D11_USAGE_DEFAULT,
         D3D11_BIND_SHADER_RESOURCE, 0,
-        D3D11_RESOURCE_MISC_TEXTURECUBE, // ťʿ ؽ
+        D3D11_RESOURCE_MISC_TEXTURECUBE, // 큐브맵용 텍스춰
         DDS_LOADER_FLAGS(false), (ID3D11Resource **)texture.GetAddressOf(),
         textureResourceView.GetAddressOf(), nullptr);
 
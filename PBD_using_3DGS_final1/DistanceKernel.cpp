@@ -0,0 +1,363 @@
+﻿#include "DistanceKernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "CpuFeatures.h"
+
+#if PBD_X86
+#include <immintrin.h>
+#endif
+
+namespace jhm {
+
+namespace {
+
+// 길이가 이보다 짧은 edge는 방향을 정할 수 없으므로 건너뜀
+const float MIN_LENGTH_SQUARED = 1e-12f;
+
+// d = p0 - p1, n = d / |d|, C = |d| - restLength
+// PBD:  dLambda = -k * C / (w0 + w1)
+// XPBD: dLambda = (-C - alpha * lambda) / (w0 + w1 + alpha)
+// p0 += w0 * dLambda * n, p1 -= w1 * dLambda * n
+template <bool XPBD>
+inline void ProjectEdgeScalar(ParticleState &p, uint32_t a, uint32_t b,
+                              float restLength, float *lambda, float k,
+                              float alpha, StrainAccumulator *strain) {
+    float dx = p.px[a] - p.px[b];
+    float dy = p.py[a] - p.py[b];
+    float dz = p.pz[a] - p.pz[b];
+    float wa = p.invMass[a];
+    float wb = p.invMass[b];
+
+    float len2 = dx * dx + dy * dy + dz * dz;
+    float denom = XPBD ? wa + wb + alpha : wa + wb;
+    bool valid = len2 > MIN_LENGTH_SQUARED && denom > 0.0f;
+
+    float invLength = valid ? 1.0f / std::sqrt(len2) : 0.0f;
+    float c = len2 * invLength - restLength;
+
+    if (strain)
+        strain->Add(valid && restLength > 0.0f ? std::fabs(c) / restLength
+                                               : 0.0f);
+    if (!valid)
+        return;
+
+    float dLambda;
+    if (XPBD) {
+        dLambda = (-c - alpha * *lambda) / denom;
+        *lambda += dLambda;
+    } else {
+        dLambda = -k * c / denom;
+    }
+
+    float s = dLambda * invLength;
+    p.px[a] += wa * s * dx;
+    p.py[a] += wa * s * dy;
+    p.pz[a] += wa * s * dz;
+    p.px[b] -= wb * s * dx;
+    p.py[b] -= wb * s * dy;
+    p.pz[b] -= wb * s * dz;
+}
+
+template <bool XPBD>
+void ProjectScalar(ParticleState &p, const uint32_t *index0,
+                   const uint32_t *index1, const float *restLength,
+                   float *lambda, int begin, int end, float k, float alpha,
+                   StrainAccumulator *strain) {
+    for (int e = begin; e < end; ++e)
+        ProjectEdgeScalar<XPBD>(p, index0[e], index1[e], restLength[e],
+                                XPBD ? lambda + e : nullptr, k, alpha, strain);
+}
+
+// SIMD lane별 strain 최대값/제곱합을 누적기에 합침
+inline void MergeLanes(StrainAccumulator *strain, const float *maxLanes,
+                       const float *sumLanes, int numLanes, int count) {
+    StrainAccumulator lanes;
+    for (int j = 0; j < numLanes; ++j) {
+        lanes.maxStrain = std::max(lanes.maxStrain, maxLanes[j]);
+        lanes.sumSquared += sumLanes[j];
+    }
+    lanes.count = count;
+    strain->Merge(lanes);
+}
+
+#if PBD_X86
+// 처리한 edge 수를 반환 (나머지는 scalar로 처리)
+template <bool XPBD>
+PBD_TARGET_AVX2 int ProjectAVX2(ParticleState &p, const uint32_t *index0,
+                                const uint32_t *index1,
+                                const float *restLength, float *lambda,
+                                int count, float k, float alpha,
+                                StrainAccumulator *strain) {
+    const __m256 negK = _mm256_set1_ps(-k);
+    const __m256 vAlpha = _mm256_set1_ps(alpha);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    const __m256 minLength2 = _mm256_set1_ps(MIN_LENGTH_SQUARED);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    __m256 maxStrain = zero;
+    __m256 sumStrain = zero;
+
+    alignas(32) float result[6][8];
+
+    int e = 0;
+    for (; e + 8 <= count; e += 8) {
+        // gather
+        __m256i a = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(index0 + e));
+        __m256i b = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(index1 + e));
+
+        __m256 ax = _mm256_i32gather_ps(p.px.data(), a, 4);
+        __m256 ay = _mm256_i32gather_ps(p.py.data(), a, 4);
+        __m256 az = _mm256_i32gather_ps(p.pz.data(), a, 4);
+        __m256 bx = _mm256_i32gather_ps(p.px.data(), b, 4);
+        __m256 by = _mm256_i32gather_ps(p.py.data(), b, 4);
+        __m256 bz = _mm256_i32gather_ps(p.pz.data(), b, 4);
+        __m256 wa = _mm256_i32gather_ps(p.invMass.data(), a, 4);
+        __m256 wb = _mm256_i32gather_ps(p.invMass.data(), b, 4);
+
+        __m256 dx = _mm256_sub_ps(ax, bx);
+        __m256 dy = _mm256_sub_ps(ay, by);
+        __m256 dz = _mm256_sub_ps(az, bz);
+        __m256 len2 = _mm256_fmadd_ps(
+            dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx)));
+
+        // rsqrt (12 bits) + Newton-Raphson 1회
+        __m256 inv = _mm256_rsqrt_ps(len2);
+        inv = _mm256_mul_ps(
+            inv, _mm256_fnmadd_ps(_mm256_mul_ps(half, len2),
+                                  _mm256_mul_ps(inv, inv), threeHalves));
+
+        __m256 denom = _mm256_add_ps(wa, wb);
+        if (XPBD)
+            denom = _mm256_add_ps(denom, vAlpha);
+        __m256 valid =
+            _mm256_and_ps(_mm256_cmp_ps(len2, minLength2, _CMP_GT_OQ),
+                          _mm256_cmp_ps(denom, zero, _CMP_GT_OQ));
+
+        __m256 rest = _mm256_loadu_ps(restLength + e);
+        __m256 c = _mm256_fmsub_ps(len2, inv, rest);
+
+        if (strain) {
+            __m256 hasRest = _mm256_cmp_ps(rest, zero, _CMP_GT_OQ);
+            __m256 s = _mm256_div_ps(_mm256_andnot_ps(signMask, c), rest);
+            s = _mm256_and_ps(s, _mm256_and_ps(valid, hasRest));
+            maxStrain = _mm256_max_ps(maxStrain, s);
+            sumStrain = _mm256_fmadd_ps(s, s, sumStrain);
+        }
+
+        __m256 dLambda;
+        if (XPBD) {
+            __m256 l = _mm256_loadu_ps(lambda + e);
+            dLambda = _mm256_div_ps(
+                _mm256_sub_ps(zero, _mm256_fmadd_ps(vAlpha, l, c)), denom);
+            dLambda = _mm256_and_ps(dLambda, valid);
+            _mm256_storeu_ps(lambda + e, _mm256_add_ps(l, dLambda));
+        } else {
+            dLambda = _mm256_div_ps(_mm256_mul_ps(negK, c), denom);
+        }
+        __m256 s = _mm256_and_ps(_mm256_mul_ps(dLambda, inv), valid);
+
+        __m256 sa = _mm256_mul_ps(wa, s);
+        __m256 sb = _mm256_mul_ps(wb, s);
+        _mm256_store_ps(result[0], _mm256_fmadd_ps(sa, dx, ax));
+        _mm256_store_ps(result[1], _mm256_fmadd_ps(sa, dy, ay));
+        _mm256_store_ps(result[2], _mm256_fmadd_ps(sa, dz, az));
+        _mm256_store_ps(result[3], _mm256_fnmadd_ps(sb, dx, bx));
+        _mm256_store_ps(result[4], _mm256_fnmadd_ps(sb, dy, by));
+        _mm256_store_ps(result[5], _mm256_fnmadd_ps(sb, dz, bz));
+
+        // scatter (AVX2에는 scatter 명령이 없음)
+        for (int j = 0; j < 8; ++j) {
+            uint32_t ia = index0[e + j];
+            uint32_t ib = index1[e + j];
+            p.px[ia] = result[0][j];
+            p.py[ia] = result[1][j];
+            p.pz[ia] = result[2][j];
+            p.px[ib] = result[3][j];
+            p.py[ib] = result[4][j];
+            p.pz[ib] = result[5][j];
+        }
+    }
+
+    if (strain && e > 0) {
+        alignas(32) float maxLanes[8], sumLanes[8];
+        _mm256_store_ps(maxLanes, maxStrain);
+        _mm256_store_ps(sumLanes, sumStrain);
+        MergeLanes(strain, maxLanes, sumLanes, 8, e);
+    }
+    return e;
+}
+
+template <bool XPBD>
+PBD_TARGET_SSE41 int ProjectSSE4(ParticleState &p, const uint32_t *index0,
+                                 const uint32_t *index1,
+                                 const float *restLength, float *lambda,
+                                 int count, float k, float alpha,
+                                 StrainAccumulator *strain) {
+    const __m128 negK = _mm_set1_ps(-k);
+    const __m128 vAlpha = _mm_set1_ps(alpha);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 minLength2 = _mm_set1_ps(MIN_LENGTH_SQUARED);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    __m128 maxStrain = zero;
+    __m128 sumStrain = zero;
+
+    alignas(16) float result[6][4];
+
+    int e = 0;
+    for (; e + 4 <= count; e += 4) {
+        const uint32_t *a = index0 + e;
+        const uint32_t *b = index1 + e;
+
+        __m128 ax = _mm_setr_ps(p.px[a[0]], p.px[a[1]], p.px[a[2]], p.px[a[3]]);
+        __m128 ay = _mm_setr_ps(p.py[a[0]], p.py[a[1]], p.py[a[2]], p.py[a[3]]);
+        __m128 az = _mm_setr_ps(p.pz[a[0]], p.pz[a[1]], p.pz[a[2]], p.pz[a[3]]);
+        __m128 bx = _mm_setr_ps(p.px[b[0]], p.px[b[1]], p.px[b[2]], p.px[b[3]]);
+        __m128 by = _mm_setr_ps(p.py[b[0]], p.py[b[1]], p.py[b[2]], p.py[b[3]]);
+        __m128 bz = _mm_setr_ps(p.pz[b[0]], p.pz[b[1]], p.pz[b[2]], p.pz[b[3]]);
+        __m128 wa = _mm_setr_ps(p.invMass[a[0]], p.invMass[a[1]],
+                                p.invMass[a[2]], p.invMass[a[3]]);
+        __m128 wb = _mm_setr_ps(p.invMass[b[0]], p.invMass[b[1]],
+                                p.invMass[b[2]], p.invMass[b[3]]);
+
+        __m128 dx = _mm_sub_ps(ax, bx);
+        __m128 dy = _mm_sub_ps(ay, by);
+        __m128 dz = _mm_sub_ps(az, bz);
+        __m128 len2 = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+            _mm_mul_ps(dz, dz));
+
+        __m128 inv = _mm_rsqrt_ps(len2);
+        inv = _mm_mul_ps(
+            inv, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, len2),
+                                                    _mm_mul_ps(inv, inv))));
+
+        __m128 denom = _mm_add_ps(wa, wb);
+        if (XPBD)
+            denom = _mm_add_ps(denom, vAlpha);
+        __m128 valid = _mm_and_ps(_mm_cmpgt_ps(len2, minLength2),
+                                  _mm_cmpgt_ps(denom, zero));
+
+        __m128 rest = _mm_loadu_ps(restLength + e);
+        __m128 c = _mm_sub_ps(_mm_mul_ps(len2, inv), rest);
+
+        if (strain) {
+            __m128 hasRest = _mm_cmpgt_ps(rest, zero);
+            __m128 s = _mm_div_ps(_mm_andnot_ps(signMask, c), rest);
+            s = _mm_blendv_ps(zero, s, _mm_and_ps(valid, hasRest));
+            maxStrain = _mm_max_ps(maxStrain, s);
+            sumStrain = _mm_add_ps(sumStrain, _mm_mul_ps(s, s));
+        }
+
+        __m128 dLambda;
+        if (XPBD) {
+            __m128 l = _mm_loadu_ps(lambda + e);
+            dLambda = _mm_div_ps(
+                _mm_sub_ps(zero, _mm_add_ps(c, _mm_mul_ps(vAlpha, l))), denom);
+            dLambda = _mm_blendv_ps(zero, dLambda, valid);
+            _mm_storeu_ps(lambda + e, _mm_add_ps(l, dLambda));
+        } else {
+            dLambda = _mm_div_ps(_mm_mul_ps(negK, c), denom);
+        }
+        __m128 s = _mm_blendv_ps(zero, _mm_mul_ps(dLambda, inv), valid);
+
+        __m128 sa = _mm_mul_ps(wa, s);
+        __m128 sb = _mm_mul_ps(wb, s);
+        _mm_store_ps(result[0], _mm_add_ps(ax, _mm_mul_ps(sa, dx)));
+        _mm_store_ps(result[1], _mm_add_ps(ay, _mm_mul_ps(sa, dy)));
+        _mm_store_ps(result[2], _mm_add_ps(az, _mm_mul_ps(sa, dz)));
+        _mm_store_ps(result[3], _mm_sub_ps(bx, _mm_mul_ps(sb, dx)));
+        _mm_store_ps(result[4], _mm_sub_ps(by, _mm_mul_ps(sb, dy)));
+        _mm_store_ps(result[5], _mm_sub_ps(bz, _mm_mul_ps(sb, dz)));
+
+        for (int j = 0; j < 4; ++j) {
+            p.px[a[j]] = result[0][j];
+            p.py[a[j]] = result[1][j];
+            p.pz[a[j]] = result[2][j];
+            p.px[b[j]] = result[3][j];
+            p.py[b[j]] = result[4][j];
+            p.pz[b[j]] = result[5][j];
+        }
+    }
+
+    if (strain && e > 0) {
+        alignas(16) float maxLanes[4], sumLanes[4];
+        _mm_store_ps(maxLanes, maxStrain);
+        _mm_store_ps(sumLanes, sumStrain);
+        MergeLanes(strain, maxLanes, sumLanes, 4, e);
+    }
+    return e;
+}
+#endif
+
+template <bool XPBD>
+void ProjectDispatch(ParticleState &p, const uint32_t *index0,
+                     const uint32_t *index1, const float *restLength,
+                     float *lambda, int count, float k, float alpha,
+                     DistanceKernelType type, StrainAccumulator *strain) {
+    int done = 0;
+#if PBD_X86
+    switch (ResolveDistanceKernel(type)) {
+    case DISTANCE_KERNEL_AVX2:
+        done = ProjectAVX2<XPBD>(p, index0, index1, restLength, lambda, count,
+                                 k, alpha, strain);
+        break;
+    case DISTANCE_KERNEL_SSE4:
+        done = ProjectSSE4<XPBD>(p, index0, index1, restLength, lambda, count,
+                                 k, alpha, strain);
+        break;
+    default:
+        break;
+    }
+#endif
+    ProjectScalar<XPBD>(p, index0, index1, restLength, lambda, done, count, k,
+                        alpha, strain);
+}
+
+} // namespace
+
+DistanceKernelType ResolveDistanceKernel(DistanceKernelType type) {
+    const CpuFeatures &cpu = CpuFeatures::Get();
+    if (type == DISTANCE_KERNEL_AUTO)
+        type = DISTANCE_KERNEL_AVX2;
+    if (type == DISTANCE_KERNEL_AVX2 && !cpu.avx2)
+        type = DISTANCE_KERNEL_SSE4;
+    if (type == DISTANCE_KERNEL_SSE4 && !cpu.sse41)
+        type = DISTANCE_KERNEL_SCALAR;
+    return type;
+}
+
+const char *GetDistanceKernelName(DistanceKernelType type) {
+    switch (type) {
+    case DISTANCE_KERNEL_SCALAR:
+        return "Scalar";
+    case DISTANCE_KERNEL_SSE4:
+        return "SSE4";
+    case DISTANCE_KERNEL_AVX2:
+        return "AVX2";
+    default:
+        return "Auto";
+    }
+}
+
+void ProjectDistanceBatch(ParticleState &particles, const uint32_t *index0,
+                          const uint32_t *index1, const float *restLength,
+                          float *lambda, int count, float k, float alpha,
+                          DistanceKernelType type, StrainAccumulator *strain) {
+    if (lambda)
+        ProjectDispatch<true>(particles, index0, index1, restLength, lambda,
+                              count, k, alpha, type, strain);
+    else
+        ProjectDispatch<false>(particles, index0, index1, restLength, nullptr,
+                               count, k, alpha, type, strain);
+}
+
+} // namespace jhm
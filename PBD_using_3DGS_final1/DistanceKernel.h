@@ -0,0 +1,34 @@
+﻿#pragma once
+
+#include <cstdint>
+
+#include "ParticleState.h"
+#include "SolverResidual.h"
+
+namespace jhm {
+
+enum DistanceKernelType {
+    DISTANCE_KERNEL_AUTO = 0, // 지원되는 가장 넓은 명령어 집합 선택
+    DISTANCE_KERNEL_SCALAR = 1,
+    DISTANCE_KERNEL_SSE4 = 2, // 4 edges
+    DISTANCE_KERNEL_AVX2 = 3, // 8 edges
+};
+
+// 요청한 kernel을 CPU가 지원하지 않으면 한 단계씩 낮춰서 반환
+DistanceKernelType ResolveDistanceKernel(DistanceKernelType type);
+const char *GetDistanceKernelName(DistanceKernelType type);
+
+// edge [0, count)의 distance constraint를 예측 위치(px, py, pz)에 적용
+// index0[i], index1[i], restLength[i]가 edge i.
+// lambda == nullptr 이면 PBD (오차의 k 배 만큼 보정),
+// 아니면 XPBD (alpha = compliance / dt^2, lambda[i]에 multiplier 누적)
+// strain != nullptr 이면 보정 전 strain을 누적 (길이가 0인 edge는 0)
+// SSE4/AVX2 kernel은 여러 edge를 동시에 처리하므로 같은 호출 안의 edge끼리
+// vertex를 공유하면 안 된다 (같은 color batch). SCALAR는 순서대로 처리.
+void ProjectDistanceBatch(ParticleState &particles, const uint32_t *index0,
+                          const uint32_t *index1, const float *restLength,
+                          float *lambda, int count, float k, float alpha,
+                          DistanceKernelType type,
+                          StrainAccumulator *strain = nullptr);
+
+} // namespace jhm
@@ -1,23 +1,28 @@
-#pragma once
+﻿#pragma once
 
 #include <directxtk/SimpleMath.h>
 #include <vector>
 
 namespace jhm {
 
+// solver가 매 반복 읽는 데이터만 (12 byte)
 struct Edge {
     UINT index0;
     UINT index1;
     float restLength;
-    std::vector<UINT> edgeIndices;
+};
 
-    // Boundary Particle
-    bool visited = false;
+// Boundary Particle (MeshData::edgeParticles, edges와 같은 번호)
+// edge 위 particle의 vertex 번호는 MeshData::edgeParticleIndices
+// 그 edge를 가진 triangle 중 MeshData::edgeOwners의 triangle만 sampling
+struct EdgeParticles {
     int numEdgeParticles = -1;
+};
 
-    // Tearing
+// Tearing (MeshData::edgeCuts, edges와 같은 번호)
+struct EdgeCut {
     int cutVertexIndexUp = -1;
     int cutVertexIndexDown = -1;
 };
 
-} // namespace hlab
\ No newline at end of file
+} // namespace hlab
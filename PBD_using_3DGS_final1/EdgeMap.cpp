@@ -0,0 +1,68 @@
+﻿#include "EdgeMap.h"
+
+#include <algorithm>
+
+namespace jhm {
+
+namespace {
+
+const uint64_t EMPTY_KEY = ~uint64_t(0); // vertex 번호가 2^32 - 1일 때만 충돌
+const size_t MIN_SLOTS = 16;
+
+} // namespace
+
+void EdgeMap::Reset(size_t expectedEdges) {
+    size_t numSlots = MIN_SLOTS;
+    while (numSlots < expectedEdges * 2)
+        numSlots *= 2;
+
+    m_slots.assign(numSlots, Slot{EMPTY_KEY, 0});
+    m_count = 0;
+    m_shift = 64;
+    for (size_t n = numSlots; n > 1; n >>= 1)
+        --m_shift;
+}
+
+size_t EdgeMap::Probe(uint64_t key) const {
+    // Fibonacci hashing: 곱한 뒤 상위 bit를 쓰면 연속된 번호도 고르게 퍼짐
+    const size_t mask = m_slots.size() - 1;
+    size_t i = size_t((key * 0x9e3779b97f4a7c15ull) >> m_shift);
+    while (m_slots[i].key != key && m_slots[i].key != EMPTY_KEY)
+        i = (i + 1) & mask;
+    return i;
+}
+
+void EdgeMap::Rehash(size_t numSlots) {
+    std::vector<Slot> slots;
+    slots.swap(m_slots);
+    Reset(numSlots / 2);
+    for (const Slot &slot : slots) {
+        if (slot.key != EMPTY_KEY) {
+            m_slots[Probe(slot.key)] = slot;
+            ++m_count;
+        }
+    }
+}
+
+uint32_t EdgeMap::FindOrInsert(uint32_t index0, uint32_t index1,
+                               uint32_t newIndex) {
+    if (m_slots.empty())
+        Reset();
+
+    const uint64_t key = uint64_t(std::min(index0, index1)) << 32 |
+                         std::max(index0, index1);
+    size_t i = Probe(key);
+    if (m_slots[i].key == key)
+        return m_slots[i].value;
+
+    // 절반 이상 차면 두 배로 늘린 뒤 다시 찾음
+    if ((m_count + 1) * 2 > m_slots.size()) {
+        Rehash(m_slots.size() * 2);
+        i = Probe(key);
+    }
+    m_slots[i] = Slot{key, newIndex};
+    ++m_count;
+    return newIndex;
+}
+
+} // namespace jhm
@@ -0,0 +1,37 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jhm {
+
+// (작은 vertex 번호, 큰 vertex 번호) -> edge 번호 hash map
+// open addressing (linear probing), 크기는 2의 거듭제곱이고 절반이 차면 두 배
+// mesh 생성과 LineCut 후 edge 재구성에서 삼각형 변마다 중복 edge를 찾는 용도
+class EdgeMap {
+  public:
+    // 비우고 expectedEdges개를 넣어도 커지지 않도록 미리 잡음
+    void Reset(size_t expectedEdges = 0);
+
+    // (index0, index1) edge가 있으면 그 번호, 없으면 newIndex로 추가하고 반환
+    uint32_t FindOrInsert(uint32_t index0, uint32_t index1, uint32_t newIndex);
+
+    size_t GetCount() const { return m_count; }
+
+  private:
+    struct Slot {
+        uint64_t key; // EMPTY_KEY면 빈 칸
+        uint32_t value;
+    };
+
+    size_t Probe(uint64_t key) const;
+    void Rehash(size_t numSlots);
+
+  private:
+    std::vector<Slot> m_slots;
+    size_t m_count = 0;
+    int m_shift = 64; // hash의 상위 bit만 사용 (64 - log2(slot 수))
+};
+
+} // namespace jhm
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "GeometryGenerator.h"
+#include "ThreadPool.h"
 
 namespace jhm {
 
@@ -43,6 +44,11 @@ bool ExampleApp::Initialize() {
     m_meshGroupCharacter.m_specularResView = m_cubeMapping.m_specularResView;
     m_meshGroup.push_back(&m_meshGroupCharacter);
 
+    for (auto *group : m_meshGroup)
+        m_scene.Register(group);
+    // 바닥 (중력을 켜면 여기에 떨어짐)
+    m_scene.GetColliders().AddPlane(Vector3(0.0f, 1.0f, 0.0f), -1.0f);
+
     //BuildFilters();
 
     return true;
@@ -64,25 +70,23 @@ void ExampleApp::Update(float dt) {
             visibleMeshGroup.MouseDrag(p.x, p.y, m_screenWidth, m_screenHeight);
     }
 
-    // PBD Simulation Update
-    visibleMeshGroup.ApplyExtForces(dt);
-
-    for (int i = 0; i < 5; ++i)
-    {
-        visibleMeshGroup.ProjectDistanceConstraints();
-        visibleMeshGroup.SolveOverpressureConstraints();
+    // PBD Simulation Update (모든 그룹)
+    m_scene.Step(dt);
+
+    // 렌더링 데이터는 보이는 그룹만, 시뮬레이션 결과가 바뀌었을 때만 업데이트
+    // (잠든 그룹은 이전에 올린 버퍼를 그대로 사용)
+    if (visibleMeshGroup.m_renderDirty) {
+        visibleMeshGroup.UpdateNormal();
+        visibleMeshGroup.UpdateParticles();
+
+        // NormalLines & Buffer Update
+        visibleMeshGroup.UpdateNormalLines(m_device, m_context);
+        // Vertext Buffer Update
+        visibleMeshGroup.UpdateVertexBuffers(m_device, m_context);
+        visibleMeshGroup.UpdateIndexBuffers(m_device, m_context);
+        visibleMeshGroup.m_renderDirty = false;
     }
 
-    visibleMeshGroup.Integrate(dt);
-    visibleMeshGroup.UpdateNormal();
-    visibleMeshGroup.UpdateParticles();
-
-    // NormalLines & Buffer Update
-    visibleMeshGroup.UpdateNormalLines(m_device, m_context);
-    // Vertext Buffer Update
-    visibleMeshGroup.UpdateVertexBuffers(m_device, m_context);
-    visibleMeshGroup.UpdateIndexBuffers(m_device, m_context);
-
     // Constant Update
     auto modelRow = Matrix::CreateScale(m_modelScaling) *
                     Matrix::CreateRotationY(m_modelRotation.y) *
@@ -314,7 +318,7 @@ void ExampleApp::LineCut(Vector2 line)
 void ExampleApp::UpdateGUI() {
     if (ImGui::Button("Change Mesh Model")) {
         m_visibleMeshIndex += 1;
-        m_visibleMeshIndex %= 3;
+        m_visibleMeshIndex %= int(m_meshGroup.size());
     }
     if (ImGui::Button("Line Cutting")) {
         m_meshGroup[m_visibleMeshIndex]->m_LineCollision = true;
@@ -330,6 +334,24 @@ void ExampleApp::UpdateGUI() {
     {
        m_meshGroup[m_visibleMeshIndex]->PrintParticleCount();
     }
+    if (ImGui::Button("Compact Particles"))
+        m_meshGroup[m_visibleMeshIndex]->CompactParticles();
+    ImGui::SliderFloat("Compaction Threshold",
+                       &m_meshGroup[m_visibleMeshIndex]->m_compactionThreshold,
+                       0.0f, 1.0f);
+    ImGui::Text("Compactions %d, last %.1f KB reclaimed, %.3f ms",
+                m_meshGroup[m_visibleMeshIndex]->m_numCompactions,
+                m_meshGroup[m_visibleMeshIndex]->m_compactionBytes / 1024.0,
+                m_meshGroup[m_visibleMeshIndex]->m_compactionMs);
+    ImGui::SliderFloat("Resample Hysteresis",
+                       &m_meshGroup[m_visibleMeshIndex]->m_resampleHysteresis,
+                       0.0f, 1.0f);
+    ImGui::SliderInt("Resample Budget",
+                     &m_meshGroup[m_visibleMeshIndex]->m_resampleBudget, 0,
+                     65536);
+    ImGui::Text("Resampled %d, deferred %d",
+                m_meshGroup[m_visibleMeshIndex]->m_numResamples,
+                m_meshGroup[m_visibleMeshIndex]->m_numDeferredResamples);
     ImGui::SliderFloat("Particle Distance",
                        &m_meshGroup[m_visibleMeshIndex]->m_particle_distance,
                        0.0f, 0.1f);
@@ -340,6 +362,123 @@ void ExampleApp::UpdateGUI() {
 
     ImGui::SliderFloat("m_modelVolume", &m_meshGroup[m_visibleMeshIndex]->m_volumePressure,
                         0.1f, 2.0f);
+    const char *volumeTrackingModes[] = {"Full", "Incremental", "Verify"};
+    ImGui::Combo("Volume Tracking",
+                 &m_meshGroup[m_visibleMeshIndex]->m_volumeTracking,
+                 volumeTrackingModes, IM_ARRAYSIZE(volumeTrackingModes));
+    if (m_meshGroup[m_visibleMeshIndex]->m_volumeTracking ==
+        VOLUME_TRACKING_VERIFY)
+        ImGui::Text("Volume drift %.2e",
+                    m_meshGroup[m_visibleMeshIndex]->m_volumeDrift);
+
+    const char *solverTypes[] = {"Gauss-Seidel", "Colored Gauss-Seidel",
+                                 "Jacobi", "Blocked Gauss-Seidel"};
+    ImGui::Combo("Solver", &m_meshGroup[m_visibleMeshIndex]->m_solverType,
+                 solverTypes, IM_ARRAYSIZE(solverTypes));
+    ImGui::SliderInt("Solver Threads",
+                     &m_meshGroup[m_visibleMeshIndex]->m_numThreads, 0,
+                     ThreadPool::Get().GetNumThreads());
+    if (m_meshGroup[m_visibleMeshIndex]->m_solverType == PBD_SOLVER_JACOBI)
+        ImGui::SliderFloat("Jacobi Omega",
+                           &m_meshGroup[m_visibleMeshIndex]->m_jacobiOmega,
+                           1.0f, 2.0f);
+    if (m_meshGroup[m_visibleMeshIndex]->m_solverType ==
+        PBD_SOLVER_BLOCKED_GAUSS_SEIDEL)
+        ImGui::SliderInt("Block Iterations",
+                         &m_meshGroup[m_visibleMeshIndex]->m_blockIterations, 1,
+                         10);
+    ImGui::SliderInt("Substeps", &m_meshGroup[m_visibleMeshIndex]->m_numSubsteps,
+                     1, 16);
+    ImGui::SliderInt("Iterations",
+                     &m_meshGroup[m_visibleMeshIndex]->m_numIterations, 1, 50);
+    ImGui::Checkbox("Early Termination",
+                    &m_meshGroup[m_visibleMeshIndex]->m_earlyTermination);
+    if (m_meshGroup[m_visibleMeshIndex]->m_earlyTermination)
+        ImGui::InputFloat("Tolerance",
+                          &m_meshGroup[m_visibleMeshIndex]->m_tolerance, 0.0f,
+                          0.0f, "%.1e");
+
+    ImGui::Checkbox("Self Collision",
+                    &m_meshGroup[m_visibleMeshIndex]->m_useSelfCollision);
+    if (m_meshGroup[m_visibleMeshIndex]->m_useSelfCollision) {
+        ImGui::SliderFloat(
+            "Collision Distance (x edge)",
+            &m_meshGroup[m_visibleMeshIndex]->m_selfCollisionScale, 0.1f,
+            1.0f);
+        ImGui::Text("Contacts %d, broadphase %.3f ms, narrowphase %.3f ms",
+                    m_meshGroup[m_visibleMeshIndex]->m_numContacts,
+                    m_meshGroup[m_visibleMeshIndex]->m_broadphaseMs,
+                    m_meshGroup[m_visibleMeshIndex]->m_narrowphaseMs);
+    }
+    ImGui::SliderFloat("Gravity", &m_meshGroup[m_visibleMeshIndex]->m_gravity,
+                       0.0f, 9.8f);
+    ImGui::SliderFloat("Collider Margin",
+                       &m_meshGroup[m_visibleMeshIndex]->m_colliderMargin, 0.0f,
+                       0.05f);
+    ImGui::Text("Colliders %d, candidates %d, contacts %d, %.3f ms",
+                m_scene.GetColliders().GetCount(),
+                m_meshGroup[m_visibleMeshIndex]->m_numColliderCandidates,
+                m_meshGroup[m_visibleMeshIndex]->m_numColliderContacts,
+                m_meshGroup[m_visibleMeshIndex]->m_colliderMs);
+    ImGui::Checkbox("Multigrid", &m_meshGroup[m_visibleMeshIndex]->m_useMultigrid);
+    if (m_meshGroup[m_visibleMeshIndex]->m_useMultigrid) {
+        ImGui::SliderInt(
+            "Coarse Iterations",
+            &m_meshGroup[m_visibleMeshIndex]->m_multigridCoarseIterations, 1,
+            10);
+        ImGui::Text("Coarse levels: %d",
+                    m_meshGroup[m_visibleMeshIndex]->GetMultigridLevelCount());
+    }
+    ImGui::Checkbox("Chebyshev", &m_meshGroup[m_visibleMeshIndex]->m_useChebyshev);
+    if (m_meshGroup[m_visibleMeshIndex]->m_useChebyshev) {
+        ImGui::SliderInt("Chebyshev Warm-up",
+                         &m_meshGroup[m_visibleMeshIndex]->m_chebyshevWarmup,
+                         1, 10);
+        ImGui::SliderFloat("Chebyshev Rho (0: auto)",
+                           &m_meshGroup[m_visibleMeshIndex]->m_chebyshevRho,
+                           0.0f, 0.99f);
+    }
+
+    SolverResidual residual = m_meshGroup[m_visibleMeshIndex]->GetResidual();
+    ImGui::Text("Iterations/frame: %d", residual.iterations);
+    ImGui::Text("Strain max %.4f rms %.4f", residual.maxStrain,
+                residual.rmsStrain);
+    ImGui::Text("Volume error %.4f", residual.volumeError);
+
+    ImGui::Checkbox("Sleep", &m_meshGroup[m_visibleMeshIndex]->m_useSleep);
+    int numSleeping, numIslands;
+    m_meshGroup[m_visibleMeshIndex]->GetIslandCount(numSleeping, numIslands);
+    ImGui::Text("Sleeping islands %d / %d", numSleeping, numIslands);
+
+    ImGui::Checkbox("Parallel Scene Step", &m_scene.m_parallel);
+    ImGui::Text("Scene step %.2f ms", m_scene.GetStepTimeMs());
+    for (int i = 0; i < m_scene.GetGroupCount(); ++i)
+        ImGui::Text("  Group %d%s: %.2f ms", i,
+                    i == m_visibleMeshIndex ? " (visible)" : "",
+                    m_scene.GetGroupTimeMs(i));
+    ImGui::Checkbox("XPBD", &m_meshGroup[m_visibleMeshIndex]->m_useXPBD);
+    if (m_meshGroup[m_visibleMeshIndex]->m_useXPBD) {
+        ImGui::InputFloat("Distance Compliance",
+                          &m_meshGroup[m_visibleMeshIndex]->m_distanceCompliance,
+                          0.0f, 0.0f, "%.2e");
+        ImGui::InputFloat("Volume Compliance",
+                          &m_meshGroup[m_visibleMeshIndex]->m_volumeCompliance,
+                          0.0f, 0.0f, "%.2e");
+    } else {
+        ImGui::SliderFloat("Distance Stiffness",
+                           &m_meshGroup[m_visibleMeshIndex]->m_distanceStiffness,
+                           0.0f, 1.0f);
+        ImGui::SliderFloat("Volume Stiffness",
+                           &m_meshGroup[m_visibleMeshIndex]->m_volumeStiffness,
+                           0.0f, 1.0f);
+    }
+    if (m_meshGroup[m_visibleMeshIndex]->m_solverType ==
+        PBD_SOLVER_COLORED_GAUSS_SEIDEL) {
+        const char *kernelTypes[] = {"Auto", "Scalar", "SSE4", "AVX2"};
+        ImGui::Combo("Distance Kernel",
+                     &m_meshGroup[m_visibleMeshIndex]->m_distanceKernel,
+                     kernelTypes, IM_ARRAYSIZE(kernelTypes));
+    }
 
     ImGui::Checkbox("Draw Noraml", &m_meshGroup[m_visibleMeshIndex]->m_drawNormals);
     ImGui::Checkbox("Wireframe", &m_drawAsWire);
@@ -11,6 +11,7 @@
 #include "Light.h"
 #include "BasicMeshGroup.h"
 #include "ImageFilter.h"
+#include "SimulationScene.h"
 
 namespace jhm {
 
@@ -38,6 +39,7 @@ class ExampleApp : public AppBase {
     BasicMeshGroup m_meshGroupObject;
     BasicMeshGroup m_meshGroupCharacter;
     vector<BasicMeshGroup *> m_meshGroup;
+    SimulationScene m_scene; // 보이지 않는 그룹도 매 프레임 시뮬레이션
     CubeMapping m_cubeMapping;
 
     bool m_usePerspectiveProjection = true;
@@ -8,22 +8,18 @@ using namespace std;
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
 
-int GeometryGenerator::AddEdge(UINT index0, UINT index1, MeshData &mesh) {
+int GeometryGenerator::AddEdge(UINT index0, UINT index1, MeshData &mesh,
+                               EdgeMap &edgeMap) {
 
-    int curIndex = 0;
     UINT idx0 = min(index0, index1);
     UINT idx1 = max(index0, index1);
     vector<Vertex> &vertices = mesh.vertices;
     vector<Edge> &edges = mesh.edges;
 
-    for (auto &e : edges) {
-        // 이미 추가된 edge인 경우
-        if (e.index0 == idx0 && e.index1 == idx1) {
-
-            return curIndex;
-        }
-        ++curIndex;
-    }
+    // 이미 추가된 edge인 경우 그 번호
+    UINT curIndex = edgeMap.FindOrInsert(idx0, idx1, UINT(edges.size()));
+    if (curIndex < edges.size())
+        return curIndex;
 
     // 새로운 edge 추가
     edges.push_back(
@@ -287,7 +283,6 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
     MeshData meshData;
 
     vector<Vertex> &vertices = meshData.vertices;
-    vector<VertexPBD> &verticesPBD = meshData.verticesPBD;
 
     for (int j = 0; j <= numStacks; j++) {
 
@@ -298,24 +293,18 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
         // 원 꼭짓점
         if (j == 0 || j == numStacks) {
             Vertex v;
-            VertexPBD vPBD;
 
             v.position = stackStartPoint;
             v.normal = v.position;
             v.normal.Normalize();
 
-            vPBD.invMass = 1.0f;
-            vPBD.newPosition = Vector3(0.0, 0.0, 0.0);
-            vPBD.velocity = Vector3(0.0, 0.0, 0.0);
-
             vertices.push_back(v);
-            meshData.verticesPBD.push_back(vPBD);
+            meshData.particles.PushBack(v.position);
         }
 
         else {
             for (int i = 0; i < numSlices; i++) {
                 Vertex v;
-                VertexPBD vPBD;
 
                 // 시작점을 x-z 평면에서 회전시키면서 원을 만드는 구조
                 v.position = Vector3::Transform(
@@ -327,12 +316,8 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
                 v.texcoord =
                     Vector2(float(i) / numSlices, 1.0f - float(j) / numStacks);
 
-                vPBD.invMass = 1.0f;
-                vPBD.newPosition = Vector3(0.0, 0.0, 0.0);
-                vPBD.velocity = Vector3(0.0, 0.0, 0.0);
-
                 vertices.push_back(v);
-                meshData.verticesPBD.push_back(vPBD);
+                meshData.particles.PushBack(v.position);
             }
         }
     }
@@ -345,6 +330,8 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
     int offset = 0;
     float volume = 0.0f;
     Triangle t;
+    EdgeMap edgeMap;
+    edgeMap.Reset(size_t(numSlices) * numStacks * 3);
     for (int j = 0; j < numStacks; j++) {
 
         if (j == 0) {
@@ -367,9 +354,9 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
                 t.vertexIndices[1] = index1;
                 t.vertexIndices[2] = index2;
 
-                t.edgeIndices[0] = AddEdge(index0, index1, meshData);
-                t.edgeIndices[1] = AddEdge(index1, index2, meshData);
-                t.edgeIndices[2] = AddEdge(index2, index0, meshData);
+                t.edgeIndices[0] = AddEdge(index0, index1, meshData, edgeMap);
+                t.edgeIndices[1] = AddEdge(index1, index2, meshData, edgeMap);
+                t.edgeIndices[2] = AddEdge(index2, index0, meshData, edgeMap);
 
                 triangles.push_back(t);
             }
@@ -394,9 +381,9 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
                 t.vertexIndices[1] = index1;
                 t.vertexIndices[2] = index2;
 
-                t.edgeIndices[0] = AddEdge(index0, index1, meshData);
-                t.edgeIndices[1] = AddEdge(index1, index2, meshData);
-                t.edgeIndices[2] = AddEdge(index2, index0, meshData);
+                t.edgeIndices[0] = AddEdge(index0, index1, meshData, edgeMap);
+                t.edgeIndices[1] = AddEdge(index1, index2, meshData, edgeMap);
+                t.edgeIndices[2] = AddEdge(index2, index0, meshData, edgeMap);
 
                 triangles.push_back(t);
             }
@@ -421,9 +408,9 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
                 t.vertexIndices[1] = index1;
                 t.vertexIndices[2] = index2;
 
-                t.edgeIndices[0] = AddEdge(index0, index1, meshData);
-                t.edgeIndices[1] = AddEdge(index1, index2, meshData);
-                t.edgeIndices[2] = AddEdge(index2, index0, meshData);
+                t.edgeIndices[0] = AddEdge(index0, index1, meshData, edgeMap);
+                t.edgeIndices[1] = AddEdge(index1, index2, meshData, edgeMap);
+                t.edgeIndices[2] = AddEdge(index2, index0, meshData, edgeMap);
 
                 triangles.push_back(t);
 
@@ -445,9 +432,9 @@ MeshData GeometryGenerator::MakeSphere(const float radius, const int numSlices,
                 t.vertexIndices[1] = index1;
                 t.vertexIndices[2] = index2;
 
-                t.edgeIndices[0] = AddEdge(index0, index1, meshData);
-                t.edgeIndices[1] = AddEdge(index1, index2, meshData);
-                t.edgeIndices[2] = AddEdge(index2, index0, meshData);
+                t.edgeIndices[0] = AddEdge(index0, index1, meshData, edgeMap);
+                t.edgeIndices[1] = AddEdge(index1, index2, meshData, edgeMap);
+                t.edgeIndices[2] = AddEdge(index2, index0, meshData, edgeMap);
 
                 triangles.push_back(t);
             }
@@ -503,12 +490,7 @@ MeshData GeometryGenerator::MakeTriangle(const float scale) {
         v.normal = normals[i];
         v.texcoord = texcoords[i];
         meshData.vertices.push_back(v);
-
-        VertexPBD v2;
-        v2.invMass = 1.0f;
-        v2.newPosition = Vector3(0.0, 0.0, 0.0);
-        v2.velocity = Vector3(0.0, 0.0, 0.0);
-        meshData.verticesPBD.push_back(v2);
+        meshData.particles.PushBack(v.position);
     }
 
     meshData.indices = {
@@ -519,6 +501,7 @@ MeshData GeometryGenerator::MakeTriangle(const float scale) {
     };
 
     Triangle t;
+    EdgeMap edgeMap;
     for (int i = 0; i < meshData.indices.size(); i = i + 3) {
         int index0 = meshData.indices[i];
         int index1 = meshData.indices[i + 1];
@@ -528,9 +511,9 @@ MeshData GeometryGenerator::MakeTriangle(const float scale) {
         t.vertexIndices[1] = index1;
         t.vertexIndices[2] = index2;
 
-        t.edgeIndices[0] = AddEdge(index0, index1, meshData);
-        t.edgeIndices[1] = AddEdge(index1, index2, meshData);
-        t.edgeIndices[2] = AddEdge(index2, index0, meshData);
+        t.edgeIndices[0] = AddEdge(index0, index1, meshData, edgeMap);
+        t.edgeIndices[1] = AddEdge(index1, index2, meshData, edgeMap);
+        t.edgeIndices[2] = AddEdge(index2, index0, meshData, edgeMap);
 
         meshData.triangles.push_back(t);
     }
@@ -594,12 +577,7 @@ MeshData GeometryGenerator::MakePlane(const float scale) {
         v.normal = normals[i];
         v.texcoord = texcoords[i];
         meshData.vertices.push_back(v);
-
-        VertexPBD v2;
-        v2.invMass = 1.0f;
-        v2.newPosition = Vector3(0.0, 0.0, 0.0);
-        v2.velocity = Vector3(0.0, 0.0, 0.0);
-        meshData.verticesPBD.push_back(v2);
+        meshData.particles.PushBack(v.position);
     }
 
     meshData.indices = {
@@ -608,6 +586,7 @@ MeshData GeometryGenerator::MakePlane(const float scale) {
     };
 
     Triangle t;
+    EdgeMap edgeMap;
     for (int i = 0; i < meshData.indices.size(); i = i + 3) {
         int index0 = meshData.indices[i];
         int index1 = meshData.indices[i + 1];
@@ -617,9 +596,9 @@ MeshData GeometryGenerator::MakePlane(const float scale) {
         t.vertexIndices[1] = index1;
         t.vertexIndices[2] = index2;
 
-        t.edgeIndices[0] = AddEdge(index0, index1, meshData);
-        t.edgeIndices[1] = AddEdge(index1, index2, meshData);
-        t.edgeIndices[2] = AddEdge(index2, index0, meshData);
+        t.edgeIndices[0] = AddEdge(index0, index1, meshData, edgeMap);
+        t.edgeIndices[1] = AddEdge(index1, index2, meshData, edgeMap);
+        t.edgeIndices[2] = AddEdge(index2, index0, meshData, edgeMap);
 
         meshData.triangles.push_back(t);
     }
@@ -796,7 +775,8 @@ MeshData GeometryGenerator::SubdivideToSphere(const float radius,
     return newMesh;
 }
 vector<MeshData> GeometryGenerator::ReadFromFile(std::string basePath,
-                                                 std::string filename) {
+                                                 std::string filename,
+                                                 MeshOrdering ordering) {
 
     using namespace DirectX;
 
@@ -829,11 +809,17 @@ vector<MeshData> GeometryGenerator::ReadFromFile(std::string basePath,
             v.position.y = (v.position.y - cy) / dl;
             v.position.z = (v.position.z - cz) / dl;
         }
+
+        // 정규화된 위치로 시뮬레이션 상태 초기화
+        for (auto &v : mesh.vertices)
+            mesh.particles.PushBack(v.position);
     }
 
     for (auto &mesh : meshes) {
         vector<Triangle> &triangles = mesh.triangles;
         Triangle t;
+        EdgeMap edgeMap;
+        edgeMap.Reset(mesh.indices.size() / 2); // 닫힌 mesh: E = 1.5 T
         float volume = 0.0f;
         for (int i = 0; i < mesh.indices.size(); i = i + 3) {
             int index0 = mesh.indices[i];
@@ -850,13 +836,18 @@ vector<MeshData> GeometryGenerator::ReadFromFile(std::string basePath,
             t.vertexIndices[1] = index1;
             t.vertexIndices[2] = index2;
 
-            t.edgeIndices[0] = AddEdge(index0, index1, mesh);
-            t.edgeIndices[1] = AddEdge(index1, index2, mesh);
-            t.edgeIndices[2] = AddEdge(index2, index0, mesh);
+            t.edgeIndices[0] = AddEdge(index0, index1, mesh, edgeMap);
+            t.edgeIndices[1] = AddEdge(index1, index2, mesh, edgeMap);
+            t.edgeIndices[2] = AddEdge(index2, index0, mesh, edgeMap);
 
             triangles.push_back(t);
         }
         mesh.m_volume = volume;
+
+        // 파일의 vertex 순서는 공간적으로 흩어져 있으므로 solver가 edge를
+        // 따라 읽을 때 cache miss가 나지 않도록 재배치
+        ReorderMesh(mesh, ordering);
+
         cout << "vertices size: " << mesh.vertices.size() << endl;
         cout << "indices size: " << mesh.indices.size() << endl;
         cout << "edges size: " << mesh.edges.size() << endl;
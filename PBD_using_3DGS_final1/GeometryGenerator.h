@@ -5,14 +5,18 @@
 #include <string>
 
 #include "Vertex.h"
+#include "EdgeMap.h"
 #include "MeshData.h"
+#include "MeshReordering.h"
 
 namespace jhm {
 
 class GeometryGenerator {
   public:
-    static vector<MeshData> ReadFromFile(std::string basePath,
-                                         std::string filename);
+    // ordering: edge / triangle 생성 후 vertex 순서 재배치 (cache locality)
+    static vector<MeshData>
+    ReadFromFile(std::string basePath, std::string filename,
+                 MeshOrdering ordering = MESH_ORDER_RCM);
 
     static MeshData MakeSquare();
     static MeshData MakeBox(const float scale = 1.0f);
@@ -27,6 +31,9 @@ class GeometryGenerator {
     static MeshData MakeIcosahedron();
     static MeshData SubdivideToSphere(const float radius, MeshData meshData);
 
-    static int AddEdge(UINT index0, UINT index1, MeshData &mesh);
+    // (index0, index1) edge 번호, 없으면 mesh.edges에 추가
+    // edgeMap: 같은 mesh에 추가한 edge의 hash map (mesh마다 하나)
+    static int AddEdge(UINT index0, UINT index1, MeshData &mesh,
+                       EdgeMap &edgeMap);
 };
 } // namespace hlab
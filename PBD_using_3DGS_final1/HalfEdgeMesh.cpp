@@ -0,0 +1,210 @@
+﻿#include "HalfEdgeMesh.h"
+
+#include <algorithm>
+
+#include "MeshData.h"
+
+namespace jhm {
+
+namespace {
+
+uint32_t AddSplitEdge(MeshData &meshData, uint32_t i, uint32_t j) {
+    const auto &vertices = meshData.vertices;
+    meshData.edges.push_back(
+        {std::min(i, j), std::max(i, j),
+         (vertices[i].position - vertices[j].position).Length()});
+    return uint32_t(meshData.edges.size() - 1);
+}
+
+} // namespace
+
+void HalfEdgeMesh::Build(const MeshData &meshData) {
+    const auto &triangles = meshData.triangles;
+    const size_t numHalfEdges = triangles.size() * 3;
+
+    m_from.resize(numHalfEdges);
+    m_edge.resize(numHalfEdges);
+    m_twin.assign(numHalfEdges, INVALID);
+    m_edgeHalfEdge.assign(meshData.edges.size(), INVALID);
+    m_outgoing.assign(meshData.vertices.size(), INVALID);
+    m_numNonManifoldEdges = 0;
+
+    // 같은 edge의 두 번째 half-edge를 첫 번째와 twin으로
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const int h = int(t * 3 + k);
+            const uint32_t e = triangles[t].edgeIndices[k];
+            m_from[h] = triangles[t].vertexIndices[k];
+            m_edge[h] = e;
+            m_outgoing[m_from[h]] = h;
+
+            const int other = m_edgeHalfEdge[e];
+            if (other == INVALID)
+                m_edgeHalfEdge[e] = h;
+            else if (m_twin[other] == INVALID && m_from[other] != m_from[h])
+                SetTwin(other, h);
+            else
+                ++m_numNonManifoldEdges; // 세 번째 face 또는 winding 불일치
+        }
+    }
+
+    // 경계 vertex는 경계 half-edge에서 fan을 시작하도록
+    for (size_t h = 0; h < numHalfEdges; ++h)
+        if (m_twin[h] == INVALID)
+            m_outgoing[m_from[h]] = int(h);
+}
+
+void HalfEdgeMesh::GetBoundaryLoops(std::vector<uint32_t> &loopOffsets,
+                                    std::vector<int> &loopHalfEdges) const {
+    loopOffsets.assign(1, 0);
+    loopHalfEdges.clear();
+    std::vector<bool> visited(m_twin.size(), false);
+
+    for (int start = 0; start < int(m_twin.size()); ++start) {
+        if (m_twin[start] != INVALID || visited[start])
+            continue;
+
+        int h = start;
+        do {
+            visited[h] = true;
+            loopHalfEdges.push_back(h);
+            // 도착 vertex의 fan을 돌아 다음 경계 half-edge로
+            h = Next(h);
+            while (m_twin[h] != INVALID)
+                h = Next(m_twin[h]);
+        } while (!visited[h]);
+        loopOffsets.push_back(uint32_t(loopHalfEdges.size()));
+    }
+}
+
+void HalfEdgeMesh::MoveHalfEdge(int from, int to) {
+    SetTwin(to, m_twin[from]);
+    if (m_outgoing[m_from[to]] == from)
+        m_outgoing[m_from[to]] = to;
+    if (m_edgeHalfEdge[m_edge[to]] == from)
+        m_edgeHalfEdge[m_edge[to]] = to;
+}
+
+int HalfEdgeMesh::SplitFace(MeshData &meshData, int h, uint32_t m,
+                            uint32_t eHead, uint32_t eTail) {
+    auto &triangles = meshData.triangles;
+    const int f = Face(h);
+    const int k = h % 3;
+    const int hn = Next(h);
+    const uint32_t to = To(h);
+    const uint32_t c = m_from[Prev(h)];
+    const uint32_t eMc = AddSplitEdge(meshData, m, c);
+    m_edgeHalfEdge.push_back(INVALID);
+
+    // (from, to, c) -> (from, m, c) + 새 triangle (m, to, c)
+    const int t = int(triangles.size());
+    triangles.push_back(
+        {{m, to, c}, {eTail, triangles[f].edgeIndices[(k + 1) % 3], eMc}});
+    triangles[f].vertexIndices[(k + 1) % 3] = m;
+    triangles[f].edgeIndices[k] = eHead;
+    triangles[f].edgeIndices[(k + 1) % 3] = eMc;
+
+    const int tail = t * 3;
+    for (int i = 0; i < 3; ++i) {
+        m_from.push_back(triangles[t].vertexIndices[i]);
+        m_edge.push_back(triangles[t].edgeIndices[i]);
+        m_twin.push_back(INVALID);
+    }
+
+    // 원래 to -> c는 새 triangle로 옮기고 그 자리는 m -> c
+    MoveHalfEdge(hn, tail + 1);
+    m_from[hn] = m;
+    m_edge[hn] = eMc;
+    SetTwin(hn, tail + 2);
+
+    m_edge[h] = eHead;
+    m_edgeHalfEdge[eHead] = h;
+    m_edgeHalfEdge[eTail] = tail;
+    m_edgeHalfEdge[eMc] = hn;
+    m_outgoing[m] = hn;
+    return tail;
+}
+
+void HalfEdgeMesh::SplitEdge(MeshData &meshData, uint32_t e,
+                             uint32_t newVertex) {
+    const int h = m_edgeHalfEdge[e];
+    const int g = m_twin[h];
+    const uint32_t a = m_from[h];
+    const uint32_t b = To(h);
+    const uint32_t m = newVertex;
+    if (m >= m_outgoing.size())
+        m_outgoing.resize(m + 1, INVALID);
+
+    // e: a - b -> a - m, 새 edge e1: m - b
+    const auto &vertices = meshData.vertices;
+    meshData.edges[e] = {std::min(a, m), std::max(a, m),
+                         (vertices[a].position - vertices[m].position)
+                             .Length()};
+    const uint32_t e1 = AddSplitEdge(meshData, m, b);
+    m_edgeHalfEdge.push_back(INVALID);
+
+    // h: a -> m, hTail: m -> b
+    const int hTail = SplitFace(meshData, h, m, e, e1);
+    if (g == INVALID) {
+        m_twin[h] = INVALID;
+        m_outgoing[m] = hTail; // 경계 vertex
+        return;
+    }
+
+    // g: b -> m, gTail: m -> a
+    const int gTail = SplitFace(meshData, g, m, e1, e);
+    SetTwin(h, gTail);
+    SetTwin(g, hTail);
+}
+
+void HalfEdgeMesh::ReserveSplits(MeshData &meshData, size_t numSplits) {
+    // split 1번: vertex 1개, triangle 2개, edge 3개, half-edge 6개
+    meshData.vertices.reserve(meshData.vertices.size() + numSplits);
+    meshData.triangles.reserve(meshData.triangles.size() + numSplits * 2);
+    meshData.edges.reserve(meshData.edges.size() + numSplits * 3);
+    m_from.reserve(m_from.size() + numSplits * 6);
+    m_twin.reserve(m_twin.size() + numSplits * 6);
+    m_edge.reserve(m_edge.size() + numSplits * 6);
+    m_edgeHalfEdge.reserve(m_edgeHalfEdge.size() + numSplits * 3);
+    m_outgoing.reserve(m_outgoing.size() + numSplits);
+}
+
+bool HalfEdgeMesh::Validate(const MeshData &meshData) const {
+    const auto &triangles = meshData.triangles;
+    const auto &edges = meshData.edges;
+    if (m_twin.size() != triangles.size() * 3 ||
+        m_edgeHalfEdge.size() != edges.size())
+        return false;
+
+    for (int h = 0; h < int(m_twin.size()); ++h) {
+        const Triangle &t = triangles[Face(h)];
+        if (m_from[h] != t.vertexIndices[h % 3] ||
+            m_edge[h] != t.edgeIndices[h % 3])
+            return false;
+
+        const Edge &e = edges[m_edge[h]];
+        if (std::min(From(h), To(h)) != e.index0 ||
+            std::max(From(h), To(h)) != e.index1)
+            return false;
+
+        const int twin = m_twin[h];
+        if (twin != INVALID &&
+            (m_twin[twin] != h || From(twin) != To(h) || To(twin) != From(h)))
+            return false;
+
+        // 경계 vertex의 fan은 경계 half-edge에서 시작
+        const int out = m_outgoing[m_from[h]];
+        if (out == INVALID || m_from[out] != m_from[h] ||
+            (twin == INVALID && m_twin[out] != INVALID))
+            return false;
+    }
+
+    for (size_t e = 0; e < edges.size(); ++e) {
+        const int h = m_edgeHalfEdge[e];
+        if (h != INVALID && m_edge[h] != e)
+            return false;
+    }
+    return true;
+}
+
+} // namespace jhm
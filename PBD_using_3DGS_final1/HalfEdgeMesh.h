@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jhm {
+
+struct MeshData;
+
+// MeshData의 triangle과 같이 유지하는 half-edge 구조
+// triangle t의 half-edge는 3t + k: vertexIndices[k] -> vertexIndices[k + 1],
+// edge는 edgeIndices[k]. 그래서 face / next / prev는 저장하지 않고 계산
+// twin이 없는(-1) half-edge가 경계. 한 edge에 triangle이 3개 이상이면
+// 처음 두 개만 twin으로 잇고 나머지는 경계로 취급
+class HalfEdgeMesh {
+  public:
+    static constexpr int INVALID = -1;
+
+    // meshData의 triangles, edges로 다시 만듦 O(T)
+    void Build(const MeshData &meshData);
+
+    int GetHalfEdgeCount() const { return int(m_twin.size()); }
+    int GetNonManifoldEdgeCount() const { return m_numNonManifoldEdges; }
+
+    static int Face(int h) { return h / 3; }
+    static int Next(int h) { return h % 3 == 2 ? h - 2 : h + 1; }
+    static int Prev(int h) { return h % 3 == 0 ? h + 2 : h - 1; }
+    int Twin(int h) const { return m_twin[h]; }
+    uint32_t From(int h) const { return m_from[h]; }
+    uint32_t To(int h) const { return m_from[Next(h)]; }
+    uint32_t GetEdge(int h) const { return m_edge[h]; }
+
+    // vertex에서 나가는 half-edge 하나 (경계 vertex면 경계 half-edge)
+    // triangle에 속하지 않은 vertex는 INVALID
+    int Outgoing(uint32_t v) const {
+        return v < m_outgoing.size() ? m_outgoing[v] : INVALID;
+    }
+    // edge의 half-edge 하나 (경계 edge면 그 유일한 half-edge)
+    int EdgeHalfEdge(uint32_t e) const { return m_edgeHalfEdge[e]; }
+
+    bool IsBoundaryHalfEdge(int h) const { return m_twin[h] == INVALID; }
+    bool IsBoundaryEdge(uint32_t e) const {
+        return m_twin[m_edgeHalfEdge[e]] == INVALID;
+    }
+    bool IsBoundaryVertex(uint32_t v) const {
+        int h = Outgoing(v);
+        return h != INVALID && m_twin[h] == INVALID;
+    }
+
+    // edge 양쪽 triangle (경계면 face1 = INVALID)
+    void GetEdgeFaces(uint32_t e, int &face0, int &face1) const {
+        int h = m_edgeHalfEdge[e];
+        face0 = Face(h);
+        face1 = m_twin[h] == INVALID ? INVALID : Face(m_twin[h]);
+    }
+
+    // v에서 나가는 half-edge를 fan 순서로 방문 (v의 triangle마다 한 번)
+    // fan이 여러 개인 non-manifold vertex는 Outgoing(v)의 fan만 방문
+    template <typename Func> void ForEachOutgoing(uint32_t v, Func func) const {
+        const int start = Outgoing(v);
+        if (start == INVALID)
+            return;
+        int h = start;
+        do {
+            func(h);
+            h = m_twin[Prev(h)];
+        } while (h != INVALID && h != start);
+    }
+
+    // v의 1-ring 이웃 vertex를 fan 순서로 방문
+    template <typename Func> void ForEachNeighbor(uint32_t v, Func func) const {
+        const int start = Outgoing(v);
+        if (start == INVALID)
+            return;
+        int h = start;
+        while (true) {
+            func(To(h));
+            int in = Prev(h);
+            h = m_twin[in];
+            if (h == INVALID) {
+                func(m_from[in]); // 경계 vertex: 마지막 triangle의 나머지 변
+                return;
+            }
+            if (h == start)
+                return;
+        }
+    }
+
+    // 경계 loop (CSR): loop l의 half-edge
+    //   loopHalfEdges[loopOffsets[l] ~ loopOffsets[l + 1]), 진행 방향 순서
+    void GetBoundaryLoops(std::vector<uint32_t> &loopOffsets,
+                          std::vector<int> &loopHalfEdges) const;
+
+    // edge e 가운데에 vertex newVertex(이미 vertices, particles에 추가됨)를
+    // 넣고 양쪽 triangle을 둘씩으로 나눔. 바뀌는 triangle, edge, half-edge만
+    // 고치므로 비용은 mesh 크기와 무관
+    // triangles, edges 뒤에 새 항목을 추가하고 e는 (한쪽 끝, newVertex)로
+    // 줄어듦. indices, boundary particle, solver 데이터는 호출한 쪽에서 갱신
+    void SplitEdge(MeshData &meshData, uint32_t e, uint32_t newVertex);
+
+    // SplitEdge를 numSplits번 해도 다시 할당하지 않도록 (meshData 포함)
+    void ReserveSplits(MeshData &meshData, size_t numSplits);
+
+    // twin / outgoing / edge 대응이 meshData와 맞는지 (디버그, 벤치마크용)
+    bool Validate(const MeshData &meshData) const;
+
+  private:
+    void SetTwin(int a, int b) {
+        m_twin[a] = b;
+        if (b != INVALID)
+            m_twin[b] = a;
+    }
+    // half-edge가 from에서 to로 옮겨졌을 때 vertex / edge 쪽 참조를 고침
+    void MoveHalfEdge(int from, int to);
+    // h(from -> to)를 from -> m으로 줄이고 새 triangle (m, to, c)를 추가
+    // h의 edge는 eHead, 새 m -> to의 edge는 eTail. 새 half-edge m -> to 반환
+    int SplitFace(MeshData &meshData, int h, uint32_t m, uint32_t eHead,
+                  uint32_t eTail);
+
+  private:
+    std::vector<uint32_t> m_from;    // half-edge 시작 vertex
+    std::vector<int> m_twin;         // 반대 방향 half-edge, 경계면 INVALID
+    std::vector<uint32_t> m_edge;    // MeshData::edges 번호
+    std::vector<int> m_outgoing;     // vertex별 나가는 half-edge
+    std::vector<int> m_edgeHalfEdge; // edge별 half-edge
+    int m_numNonManifoldEdges = 0;
+};
+
+} // namespace jhm
@@ -87,7 +87,7 @@ class ImageFilter {
         txtDesc.Width = width;
         txtDesc.Height = height;
         txtDesc.MipLevels = txtDesc.ArraySize = 1;
-        txtDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT; //  ̹ ó뵵
+        txtDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT; //  이미지 처리용도
         txtDesc.SampleDesc.Count = 1;
         txtDesc.Usage = D3D11_USAGE_DEFAULT;
         txtDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE |
@@ -113,7 +113,7 @@ class ImageFilter {
         D3D11Utils::CreateConstantBuffer(device, m_pixelConstData,
                                          m_mesh->pixelConstantBuffer);
 
-        // ⺻ Ÿ
+        // 기본 렌더타겟
         this->SetRenderTargets({m_renderTargetView});
     }
 
@@ -129,7 +129,7 @@ class ImageFilter {
         //assert(m_shaderResources.size() > 0);
         assert(m_renderTargets.size() > 0);
 
-        //    
+        // 어디에 렌더링 할지를 지정
         context->OMSetRenderTargets(UINT(m_renderTargets.size()),
                                     m_renderTargets.data(), nullptr);
         //float clearColor[4] = {0.0f, 0.0f, 0.0f, 1.0f};
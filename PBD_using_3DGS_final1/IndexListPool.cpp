@@ -0,0 +1,95 @@
+﻿#include "IndexListPool.h"
+
+#include <algorithm>
+
+namespace jhm {
+
+namespace {
+
+const uint32_t MIN_SLACK = 2;
+
+} // namespace
+
+uint32_t IndexListPool::Slack(uint32_t size) {
+    return std::max(MIN_SLACK, size / 4);
+}
+
+void IndexListPool::Reset(size_t numLists) {
+    m_offsets.assign(numLists, 0);
+    m_sizes.assign(numLists, 0);
+    m_capacities.assign(numLists, 0);
+    m_data.clear();
+    m_unused = 0;
+}
+
+void IndexListPool::Compact() {
+    size_t total = 0;
+    for (uint32_t size : m_sizes)
+        total += size + Slack(size);
+
+    m_spare.resize(total);
+    uint32_t offset = 0;
+    for (size_t l = 0; l < m_sizes.size(); ++l) {
+        std::copy_n(m_data.begin() + m_offsets[l], m_sizes[l],
+                    m_spare.begin() + offset);
+        m_offsets[l] = offset;
+        m_capacities[l] = m_sizes[l] + Slack(m_sizes[l]);
+        offset += m_capacities[l];
+    }
+    m_data.swap(m_spare);
+    m_unused = 0;
+}
+
+void IndexListPool::Reserve(size_t list, uint32_t capacity) {
+    if (capacity <= m_capacities[list])
+        return;
+
+    // 옮기면 버려질 slot까지 절반을 넘으면 먼저 전체를 다시 배치
+    if ((m_unused + m_capacities[list]) * 2 > m_data.size()) {
+        Compact();
+        if (capacity <= m_capacities[list])
+            return;
+    }
+
+    const uint32_t newCapacity = capacity + Slack(capacity);
+    if (m_offsets[list] + m_capacities[list] == m_data.size()) {
+        m_capacities[list] = newCapacity;
+        m_data.resize(m_offsets[list] + newCapacity);
+        return;
+    }
+
+    m_unused += m_capacities[list];
+    const uint32_t offset = uint32_t(m_data.size());
+    m_data.resize(offset + newCapacity);
+    std::copy_n(m_data.begin() + m_offsets[list], m_sizes[list],
+                m_data.begin() + offset);
+    m_offsets[list] = offset;
+    m_capacities[list] = newCapacity;
+}
+
+void IndexListPool::Grow(size_t list) {
+    const uint32_t size = m_sizes[list];
+
+    // 배열 끝에 있는 list는 그 자리에서 늘림
+    if (m_offsets[list] + m_capacities[list] == m_data.size()) {
+        m_capacities[list] = size + Slack(size);
+        m_data.resize(m_offsets[list] + m_capacities[list]);
+        return;
+    }
+
+    // 버려진 slot이 절반을 넘으면 전체를 다시 배치 (여유 slot이 생김)
+    m_unused += m_capacities[list];
+    if (m_unused * 2 > m_data.size()) {
+        Compact();
+        return;
+    }
+
+    const uint32_t offset = uint32_t(m_data.size());
+    m_data.resize(offset + size + Slack(size));
+    std::copy_n(m_data.begin() + m_offsets[list], size,
+                m_data.begin() + offset);
+    m_offsets[list] = offset;
+    m_capacities[list] = size + Slack(size);
+}
+
+} // namespace jhm
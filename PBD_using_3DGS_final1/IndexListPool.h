@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jhm {
+
+// 여러 개의 짧은 index list를 배열 하나에 모아 저장 (CSR + 여유 slot)
+// list l: m_data[m_offsets[l] ~ m_offsets[l] + m_sizes[l])
+// 여유 slot이 부족하면 그 list만 배열 끝으로 옮기고, 버려진 slot이 많아지면
+// 전체를 다시 배치한다. 두 배열을 번갈아 쓰므로 크기가 안정되면 할당 없음
+class IndexListPool {
+  public:
+    // numLists개의 빈 list (이미 잡은 메모리는 유지)
+    void Reset(size_t numLists);
+
+    // list마다 여유 slot을 남기고 빈틈 없이 다시 배치
+    void Compact();
+
+    size_t GetListCount() const { return m_sizes.size(); }
+    uint32_t Size(size_t list) const { return m_sizes[list]; }
+    // 다시 배치하지 않고 PushBack할 수 있는 크기. 이 안에서는 서로 다른
+    // list를 동시에 고쳐도 됨
+    uint32_t Capacity(size_t list) const { return m_capacities[list]; }
+    // Capacity(list)를 capacity 이상으로 (모자라면 Grow처럼 옮김)
+    void Reserve(size_t list, uint32_t capacity);
+
+    uint32_t &At(size_t list, uint32_t i) {
+        return m_data[m_offsets[list] + i];
+    }
+    uint32_t At(size_t list, uint32_t i) const {
+        return m_data[m_offsets[list] + i];
+    }
+    uint32_t Back(size_t list) const {
+        return m_data[m_offsets[list] + m_sizes[list] - 1];
+    }
+
+    void PushBack(size_t list, uint32_t value) {
+        if (m_sizes[list] == m_capacities[list])
+            Grow(list);
+        m_data[m_offsets[list] + m_sizes[list]++] = value;
+    }
+    void PopBack(size_t list) { --m_sizes[list]; }
+    void Clear(size_t list) { m_sizes[list] = 0; }
+
+  private:
+    void Grow(size_t list);
+    static uint32_t Slack(uint32_t size);
+
+  private:
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_sizes;
+    std::vector<uint32_t> m_capacities;
+    std::vector<uint32_t> m_data;
+    std::vector<uint32_t> m_spare; // Compact에서 번갈아 사용
+    size_t m_unused = 0;           // 옮겨진 list가 남긴 slot 수
+};
+
+} // namespace jhm
@@ -0,0 +1,13 @@
+﻿#pragma once
+
+namespace jhm {
+
+// edge로 연결된 vertex 집합. island마다 따로 sleep/wake
+struct Island {
+    int numVertices = 0;
+    float kineticEnergy = 0.0f; // vertex당 평균 운동 에너지 (질량 = 1/invMass)
+    int restFrames = 0; // kineticEnergy가 기준 아래로 유지된 연속 프레임 수
+    bool sleeping = false;
+};
+
+} // namespace jhm
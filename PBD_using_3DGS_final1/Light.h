@@ -14,7 +14,7 @@ using DirectX::SimpleMath::Vector2;
 using DirectX::SimpleMath::Vector3;
 using DirectX::SimpleMath::Vector4;
 
-// 
+// 조명
 struct Light {
     Vector3 strength = Vector3(1.0f);              // 12
     float fallOffStart = 0.0f;                     // 4
@@ -7,29 +7,167 @@
 #include <vector>
 
 #include "Vertex.h"
-#include "VertexPBD.h"
 #include "Edge.h"
+#include "HalfEdgeMesh.h"
+#include "IndexListPool.h"
+#include "Island.h"
+#include "MultigridHierarchy.h"
+#include "ParticleKernel.h"
+#include "ParticleState.h"
+#include "SolverResidual.h"
+#include "SpatialHash.h"
 #include "Triangle.h"
 
 namespace jhm {
 
 using std::vector;
 
+// UpdateParticles의 resampling 후보 (edge 또는 triangle)
+// distortion: 개수 구간을 벗어난 정도 (particle 간격 단위)
+struct ResampleCandidate {
+    float distortion;
+    UINT index;
+    bool triangle; // false면 edges 번호, true면 triangles 번호
+};
+
 struct MeshData {
     std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices; // uint32 
+    std::vector<uint32_t> indices; // uint32로 변경
     std::string textureFilename;
 
-    //PBD ߰ 
-    std::vector<VertexPBD> verticesPBD;
+    //PBD 추가 데이터
+    // vertices의 앞쪽 particles.Size()개가 시뮬레이션되는 mesh vertex
+    ParticleState particles;
     std::vector<Edge> edges;
     std::vector<Triangle> triangles;
+    // triangles의 half-edge 구조 (BuildSolverData에서 다시 만듦)
+    // 1-ring, edge 양쪽 face, 경계 판정을 O(1)로
+    HalfEdgeMesh halfEdges;
 
-    // Volume constraint ߰ 
+    // Boundary particle 추가 데이터 (edges, triangles와 같은 번호)
+    // solver가 읽지 않으므로 Edge, Triangle과 따로 저장
+    std::vector<EdgeParticles> edgeParticles;
+    std::vector<TriangleParticles> triangleParticles;
+    // edge를 sampling할 triangle (그 edge를 가진 첫 triangle)
+    std::vector<UINT> edgeOwners;
+    IndexListPool edgeParticleIndices;  // edge별 particle vertex 번호
+    IndexListPool innerParticleIndices; // triangle별 내부 particle vertex 번호
+    // downsampling으로 반납된 particle vertex (다음 할당에서 재사용)
+    std::vector<UINT> freeParticles;
+    // particle vertex의 indices 안 위치 (vertex 번호 - particles.Size())
+    std::vector<UINT> particleDrawSlots;
+    // particle vertex별 barycentric 좌표 (같은 번호): triangle
+    // particleTriangles의 꼭짓점 가중치 u, v, 1 - u - v. sampling 구조가
+    // 바뀔 때만 다시 계산하고 위치는 매 프레임 EvaluateParticles에서 계산
+    std::vector<uint32_t> particleTriangles;
+    AlignedVector<float> particleU, particleV;
+    ParticleCorners particleCorners; // EvaluateParticles의 gather 원본
+    // 블록별 resampling 후보와 이번 프레임에 처리할 후보
+    std::vector<std::vector<ResampleCandidate>> resampleCandidates;
+    std::vector<ResampleCandidate> resampleQueue;
+    // resampleQueue 항목 k의 sampling 뒤 particle 수, 미리 할당한 vertex
+    // reservedParticles[reserveOffsets[k] ~ reserveOffsets[k + 1])와
+    // ParallelFor 블록별로 반납할 vertex
+    std::vector<UINT> resampleTargets;
+    std::vector<UINT> reserveOffsets;
+    std::vector<UINT> reservedParticles;
+    std::vector<std::vector<UINT>> releasedParticles;
+
+    // Volume constraint 추가 데이터
     float m_volume;
 
-    // Tearing ߰ 
+    // 병렬 Gauss-Seidel 추가 데이터
+    // color c의 edge: coloredEdges[edgeColorOffsets[c] ~ edgeColorOffsets[c+1])
+    // 같은 color의 edge끼리는 vertex를 공유하지 않음
+    std::vector<UINT> edgeColorOffsets;
+    std::vector<UINT> coloredEdges;
+    // coloredEdges 순서로 펼친 edge 데이터 (SIMD kernel 입력)
+    std::vector<uint32_t> coloredIndex0;
+    std::vector<uint32_t> coloredIndex1;
+    std::vector<float> coloredRestLength;
+
+    // Cache-blocked Gauss-Seidel 추가 데이터
+    // vertex 번호를 L2 크기 구간(block)으로 나눔. block b의 내부 edge:
+    //   blockedIndex0[blockEdgeOffsets[b] ~ [b + 1])
+    // 마지막 offset 이후는 두 block에 걸친 border edge
+    std::vector<UINT> blockEdgeOffsets;
+    std::vector<uint32_t> blockedIndex0;
+    std::vector<uint32_t> blockedIndex1;
+    std::vector<float> blockedRestLength;
+    std::vector<float> blockedLambdas; // blocked 순서의 XPBD multiplier
+
+    // Jacobi / Volume constraint 추가 데이터
+    // vertex i에 연결된 edge: vertexEdges[vertexEdgeOffsets[i] ~ [i+1])
+    // vertex i가 속한 triangle: vertexTriangles[...] = triangle * 3 + 꼭짓점
+    std::vector<UINT> vertexEdgeOffsets;
+    std::vector<UINT> vertexEdges;
+    std::vector<UINT> vertexTriangleOffsets;
+    std::vector<UINT> vertexTriangles;
+    std::vector<Vector3> edgeDeltas;     // edge * 2 + (0: index0, 1: index1)
+    std::vector<Vector3> triangleDeltas; // triangle * 3 + 꼭짓점
+
+    // Volume constraint 계산용 버퍼 (매 반복 재사용)
+    std::vector<Vector3> volumeGradients; // vertex별 부피 gradient
+    std::vector<double> blockVolumes;     // ParallelFor 블록별 부분합
+    std::vector<double> blockGradSums;
+
+    // 증분 부피 추적 (VOLUME_TRACKING_INCREMENTAL / VERIFY)
+    // 마지막 계산 때의 예측 위치, triangle별 triple product, 부피 / gradient
+    // 제곱합. 위치가 바뀐 vertex의 triangle과 그 꼭짓점 gradient만 갱신
+    AlignedVector<float> volumeX, volumeY, volumeZ;
+    std::vector<float> triangleVolumes;
+    std::vector<uint32_t> triangleVolumeStamps; // 이번 갱신에 넣었으면 stamp
+    std::vector<uint32_t> vertexVolumeStamps;
+    std::vector<UINT> dirtyTriangles;
+    std::vector<UINT> dirtyVertices;
+    uint32_t volumeStamp = 0;
+    double trackedVolume = 0.0;
+    double trackedGradSum = 0.0;
+    int volumeUpdateCount = -1; // 전체 계산 후 증분 갱신 횟수, -1: 캐시 없음
+    int numDirtyVertices = 0;   // 마지막 증분 갱신에서 움직인 vertex 수
+    int volumeBackoff = 0;   // 바뀐 vertex가 많아 연속으로 중단한 만큼 증가
+    int volumeSkipCalls = 0; // 증분 갱신을 시도하지 않을 남은 호출 수
+
+    // Chebyshev 가속 추가 데이터
+    // q(k-1), q(k): 직전 두 반복이 끝났을 때의 예측 위치
+    AlignedVector<float> chebyshevPrevX, chebyshevPrevY, chebyshevPrevZ;
+    AlignedVector<float> chebyshevCurrX, chebyshevCurrY, chebyshevCurrZ;
+    std::vector<double> blockUpdateNorms; // ParallelFor 블록별 |q^ - q(k)|^2
+    float chebyshevRho = 0.0f; // 마지막으로 추정한 spectral radius
+
+    // Hierarchical PBD 추가 데이터 (level 1부터, 위로 갈수록 coarse)
+    std::vector<MultigridLevel> multigridLevels;
+
+    // XPBD 추가 데이터 (substep마다 0으로 초기화)
+    std::vector<float> edgeLambdas;    // edge 순서
+    std::vector<float> coloredLambdas; // coloredEdges 순서
+    float volumeLambda = 0.0f;
+
+    // Residual 추가 데이터
+    SolverResidual residual;
+    std::vector<StrainAccumulator> blockStrains; // ParallelFor 블록별 누적
+
+    // Self collision 추가 데이터
+    // collisionFilter: 충돌 검사에서 뺄 쌍 (edge, 로드할 때 가까운 쌍), 정렬됨
+    SpatialHash selfCollisionHash;
+    std::vector<uint64_t> collisionFilter;
+    size_t collisionFilterVertices = 0; // filter가 다루는 vertex 수 (0: 없음)
+    float averageEdgeLength = 0.0f;
+    std::vector<uint64_t> selfContacts; // substep마다 다시 찾음
+
+    // Static collider 추가 데이터
+    std::vector<int> colliderCandidates; // substep마다 broadphase로 다시 찾음
+    std::vector<int> blockColliderContacts; // ParallelFor 블록별 contact 수
+    int numColliderContacts = 0;            // 마지막 반복의 contact 수
+
+    // Sleep 추가 데이터 (BuildIslands에서 생성, 처음엔 모두 깨어 있음)
+    std::vector<int> vertexIslands; // vertex별 island 번호
+    std::vector<Island> islands;
+    int numSleepingIslands = 0;
+
+    // Tearing 추가 데이터
     std::vector<int> m_collisionVertices;
+    std::vector<EdgeCut> edgeCuts; // edges와 같은 번호
 };
 
 } // namespace hlab
\ No newline at end of file
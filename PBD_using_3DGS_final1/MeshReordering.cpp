@@ -0,0 +1,243 @@
+﻿#include "MeshReordering.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+namespace jhm {
+
+namespace {
+
+// 축마다 21 bit -> 63 bit Morton code
+const int MORTON_BITS = 21;
+
+uint64_t SpreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v << 8) & 0x100f00f00f00f00full;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+}
+
+// vertex 번호 순으로 정렬된 이웃 목록 (CSR)
+void BuildVertexAdjacency(const MeshData &mesh, std::vector<uint32_t> &offsets,
+                          std::vector<uint32_t> &neighbors) {
+    const size_t n = mesh.vertices.size();
+    offsets.assign(n + 1, 0);
+    for (const auto &e : mesh.edges) {
+        ++offsets[e.index0 + 1];
+        ++offsets[e.index1 + 1];
+    }
+    for (size_t i = 0; i < n; ++i)
+        offsets[i + 1] += offsets[i];
+
+    neighbors.resize(offsets[n]);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto &e : mesh.edges) {
+        neighbors[cursor[e.index0]++] = e.index1;
+        neighbors[cursor[e.index1]++] = e.index0;
+    }
+}
+
+template <typename T, typename A>
+void Permute(std::vector<T, A> &values,
+             const std::vector<uint32_t> &newToOld) {
+    if (values.size() != newToOld.size())
+        return;
+    std::vector<T, A> permuted(values.size());
+    for (size_t i = 0; i < newToOld.size(); ++i)
+        permuted[i] = values[newToOld[i]];
+    values.swap(permuted);
+}
+
+} // namespace
+
+const char *GetMeshOrderingName(MeshOrdering ordering) {
+    switch (ordering) {
+    case MESH_ORDER_MORTON:
+        return "Morton";
+    case MESH_ORDER_RCM:
+        return "RCM";
+    default:
+        return "None";
+    }
+}
+
+std::vector<uint32_t> ComputeMortonOrder(const MeshData &mesh) {
+    const size_t n = mesh.vertices.size();
+    Vector3 lo(FLT_MAX, FLT_MAX, FLT_MAX), hi(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const auto &v : mesh.vertices) {
+        lo = Vector3::Min(lo, v.position);
+        hi = Vector3::Max(hi, v.position);
+    }
+    Vector3 extent = hi - lo;
+    float scale = float((1 << MORTON_BITS) - 1) /
+                  std::max(std::max(extent.x, extent.y),
+                           std::max(extent.z, 1e-12f));
+
+    std::vector<uint64_t> codes(n);
+    for (size_t i = 0; i < n; ++i) {
+        Vector3 q = (mesh.vertices[i].position - lo) * scale;
+        codes[i] = SpreadBits(uint64_t(q.x)) |
+                   SpreadBits(uint64_t(q.y)) << 1 |
+                   SpreadBits(uint64_t(q.z)) << 2;
+    }
+
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+    return order;
+}
+
+std::vector<uint32_t> ComputeRcmOrder(const MeshData &mesh) {
+    const uint32_t n = uint32_t(mesh.vertices.size());
+    std::vector<uint32_t> offsets, neighbors;
+    BuildVertexAdjacency(mesh, offsets, neighbors);
+    auto degree = [&](uint32_t v) { return offsets[v + 1] - offsets[v]; };
+
+    // 이웃은 degree가 작은 것부터 방문
+    for (uint32_t v = 0; v < n; ++v)
+        std::sort(neighbors.begin() + offsets[v],
+                  neighbors.begin() + offsets[v + 1],
+                  [&](uint32_t a, uint32_t b) {
+                      return degree(a) != degree(b) ? degree(a) < degree(b)
+                                                    : a < b;
+                  });
+
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    std::vector<int> level(n, -1);
+
+    // start에서 BFS, 방문 순서를 visit에 추가하고 마지막 level 반환
+    auto bfs = [&](uint32_t start, std::vector<uint32_t> &visit) {
+        size_t head = visit.size();
+        visit.push_back(start);
+        level[start] = 0;
+        int last = 0;
+        for (; head < visit.size(); ++head) {
+            uint32_t v = visit[head];
+            last = level[v];
+            for (uint32_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+                uint32_t u = neighbors[k];
+                if (level[u] < 0) {
+                    level[u] = level[v] + 1;
+                    visit.push_back(u);
+                }
+            }
+        }
+        return last;
+    };
+
+    std::vector<uint32_t> component;
+    for (uint32_t seed = 0; seed < n; ++seed) {
+        if (level[seed] >= 0)
+            continue;
+
+        // pseudo-peripheral vertex: 가장 먼 level 중 degree가 가장 작은
+        // vertex에서 다시 BFS, 깊이가 더 늘지 않을 때까지 (최대 몇 번)
+        uint32_t start = seed;
+        int depth = -1;
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            component.clear();
+            int newDepth = bfs(start, component);
+            // component는 level 순서이므로 뒤쪽이 마지막 level
+            uint32_t best = component.back();
+            for (auto it = component.rbegin();
+                 it != component.rend() && level[*it] == newDepth; ++it) {
+                if (degree(*it) < degree(best))
+                    best = *it;
+            }
+            for (uint32_t v : component)
+                level[v] = -1;
+            if (newDepth <= depth)
+                break;
+            depth = newDepth;
+            start = best;
+        }
+
+        component.clear();
+        bfs(start, component);
+        order.insert(order.end(), component.begin(), component.end());
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+void ApplyVertexOrder(MeshData &mesh, const std::vector<uint32_t> &newToOld) {
+    const size_t n = mesh.vertices.size();
+    if (newToOld.size() != n)
+        return;
+    std::vector<uint32_t> oldToNew(n);
+    for (uint32_t i = 0; i < n; ++i)
+        oldToNew[newToOld[i]] = i;
+
+    Permute(mesh.vertices, newToOld);
+    ParticleState &p = mesh.particles;
+    for (auto *a : {&p.x, &p.y, &p.z, &p.px, &p.py, &p.pz, &p.vx, &p.vy,
+                    &p.vz, &p.invMass})
+        Permute(*a, newToOld);
+
+    // edge: (작은 vertex, 큰 vertex) 순서로 정렬
+    std::vector<Edge> &edges = mesh.edges;
+    for (auto &e : edges) {
+        UINT a = oldToNew[e.index0], b = oldToNew[e.index1];
+        e.index0 = std::min(a, b);
+        e.index1 = std::max(a, b);
+    }
+    std::vector<uint32_t> edgeNewToOld(edges.size());
+    std::iota(edgeNewToOld.begin(), edgeNewToOld.end(), 0u);
+    std::sort(edgeNewToOld.begin(), edgeNewToOld.end(),
+              [&](uint32_t a, uint32_t b) {
+                  const Edge &ea = edges[a], &eb = edges[b];
+                  return ea.index0 != eb.index0 ? ea.index0 < eb.index0
+                                                : ea.index1 < eb.index1;
+              });
+    std::vector<uint32_t> edgeOldToNew(edges.size());
+    for (uint32_t i = 0; i < edgeNewToOld.size(); ++i)
+        edgeOldToNew[edgeNewToOld[i]] = i;
+    Permute(edges, edgeNewToOld);
+
+    // triangle: 가장 작은 vertex 번호 순 (같으면 원래 순서)
+    std::vector<Triangle> &triangles = mesh.triangles;
+    std::vector<uint32_t> minVertex(triangles.size());
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        Triangle &tri = triangles[t];
+        for (int k = 0; k < 3; ++k) {
+            tri.vertexIndices[k] = oldToNew[tri.vertexIndices[k]];
+            tri.edgeIndices[k] = edgeOldToNew[tri.edgeIndices[k]];
+        }
+        minVertex[t] = std::min({tri.vertexIndices[0], tri.vertexIndices[1],
+                                 tri.vertexIndices[2]});
+    }
+    std::vector<uint32_t> triangleNewToOld(triangles.size());
+    std::iota(triangleNewToOld.begin(), triangleNewToOld.end(), 0u);
+    std::stable_sort(
+        triangleNewToOld.begin(), triangleNewToOld.end(),
+        [&](uint32_t a, uint32_t b) { return minVertex[a] < minVertex[b]; });
+
+    Permute(triangles, triangleNewToOld);
+
+    // 로드 직후에는 indices가 triangle과 1:1이므로 정렬된 triangle로 다시 만듦
+    if (mesh.indices.size() == triangles.size() * 3) {
+        for (size_t t = 0; t < triangles.size(); ++t)
+            for (int k = 0; k < 3; ++k)
+                mesh.indices[t * 3 + k] = triangles[t].vertexIndices[k];
+    } else {
+        for (auto &index : mesh.indices)
+            index = oldToNew[index];
+    }
+}
+
+void ReorderMesh(MeshData &mesh, MeshOrdering ordering) {
+    if (ordering == MESH_ORDER_MORTON)
+        ApplyVertexOrder(mesh, ComputeMortonOrder(mesh));
+    else if (ordering == MESH_ORDER_RCM)
+        ApplyVertexOrder(mesh, ComputeRcmOrder(mesh));
+}
+
+} // namespace jhm
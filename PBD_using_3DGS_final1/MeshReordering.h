@@ -0,0 +1,32 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshData.h"
+
+namespace jhm {
+
+// 로드 직후 vertex 순서 (메모리 상 이웃한 vertex가 공간에서도 이웃하게)
+enum MeshOrdering {
+    MESH_ORDER_NONE = 0,   // 파일 순서 그대로
+    MESH_ORDER_MORTON = 1, // 위치의 Morton(Z-order) code 순서
+    MESH_ORDER_RCM = 2,    // edge 그래프의 reverse Cuthill-McKee 순서
+};
+
+const char *GetMeshOrderingName(MeshOrdering ordering);
+
+// 새 vertex 순서 (newToOld[새 번호] = 원래 번호)
+std::vector<uint32_t> ComputeMortonOrder(const MeshData &mesh);
+std::vector<uint32_t> ComputeRcmOrder(const MeshData &mesh);
+
+// vertices, particles, indices, edges, triangles의 vertex 번호를 같은
+// 순서로 바꾸고, edge와 triangle을 가장 작은 vertex 번호 순으로 정렬
+// (삼각형의 꼭짓점 순서(winding)는 유지)
+// boundary particle과 solver 데이터가 없는 로드 직후에만 호출
+// (InitParticles, BuildSolverData 전)
+void ApplyVertexOrder(MeshData &mesh, const std::vector<uint32_t> &newToOld);
+
+void ReorderMesh(MeshData &mesh, MeshOrdering ordering);
+
+} // namespace jhm
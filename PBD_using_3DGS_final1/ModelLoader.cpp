@@ -95,13 +95,11 @@ void ModelLoader::ProcessNode(aiNode *node, const aiScene *scene, Matrix tr) {
 MeshData ModelLoader::ProcessMesh(aiMesh *mesh, const aiScene *scene) {
     // Data to fill
     std::vector<Vertex> vertices;
-    std::vector<VertexPBD> verticesPBD;
     std::vector<uint32_t> indices;
 
     // Walk through each of the mesh's vertices
     for (UINT i = 0; i < mesh->mNumVertices; i++) {
         Vertex vertex;
-        VertexPBD vertexPBD;
 
         vertex.position.x = mesh->mVertices[i].x;
         vertex.position.y = mesh->mVertices[i].y;
@@ -119,7 +117,6 @@ MeshData ModelLoader::ProcessMesh(aiMesh *mesh, const aiScene *scene) {
         }
 
         vertices.push_back(vertex);
-        verticesPBD.push_back(vertexPBD);
     }
 
     for (UINT i = 0; i < mesh->mNumFaces; i++) {
@@ -130,7 +127,6 @@ MeshData ModelLoader::ProcessMesh(aiMesh *mesh, const aiScene *scene) {
 
     MeshData newMesh;
     newMesh.vertices = vertices;
-    newMesh.verticesPBD = verticesPBD;
     newMesh.indices = indices;
 
     // http://assimp.sourceforge.net/lib_html/materials.html
@@ -0,0 +1,379 @@
+﻿#include "MultigridHierarchy.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+#include "ThreadPool.h"
+
+namespace jhm {
+
+namespace {
+
+const int MAX_LEVELS = 4;
+// vertex 수가 이보다 적은 level은 더 줄이지 않음
+const size_t MIN_COARSE_VERTICES = 32;
+// 한 번 줄였을 때 vertex 수가 이 비율보다 많이 남으면 level을 만들지 않음
+const float MAX_COARSE_RATIO = 0.8f;
+// prolongation 가중치 = 1 / (대표까지 rest 거리 + eps)
+// 대표 vertex 자신은 자기 cluster의 보정량을 거의 그대로 받음
+const float WEIGHT_EPSILON = 1e-6f;
+const int PROLONG_GRAIN_SIZE = 1024;
+
+// vertex 인접 (CSR), lengths는 그 edge의 rest length
+struct Graph {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> neighbors;
+    std::vector<float> lengths;
+};
+
+void BuildGraph(size_t numVertices, const std::vector<uint32_t> &index0,
+                const std::vector<uint32_t> &index1,
+                const std::vector<float> &restLength, Graph &graph) {
+    graph.offsets.assign(numVertices + 1, 0);
+    for (size_t e = 0; e < index0.size(); ++e) {
+        ++graph.offsets[index0[e] + 1];
+        ++graph.offsets[index1[e] + 1];
+    }
+    for (size_t i = 0; i < numVertices; ++i)
+        graph.offsets[i + 1] += graph.offsets[i];
+
+    graph.neighbors.resize(graph.offsets[numVertices]);
+    graph.lengths.resize(graph.offsets[numVertices]);
+    std::vector<uint32_t> cursor(graph.offsets.begin(),
+                                 graph.offsets.end() - 1);
+    for (size_t e = 0; e < index0.size(); ++e) {
+        graph.lengths[cursor[index0[e]]] = restLength[e];
+        graph.neighbors[cursor[index0[e]]++] = index1[e];
+        graph.lengths[cursor[index1[e]]] = restLength[e];
+        graph.neighbors[cursor[index1[e]]++] = index0[e];
+    }
+}
+
+// 이웃 순서와 무관한 vertex 이웃 signature
+uint64_t Signature(const Graph &graph, uint32_t v) {
+    uint64_t signature = graph.offsets[v + 1] - graph.offsets[v];
+    for (uint32_t j = graph.offsets[v]; j < graph.offsets[v + 1]; ++j)
+        signature += (uint64_t(graph.neighbors[j]) + 1) * 0x9E3779B97F4A7C15ull;
+    return signature;
+}
+
+// clusterOf[v] >= 0 인 vertex는 기존 cluster 유지, 나머지를 1-ring 단위로
+// 묶어서 level 생성. belowVertices == nullptr 이면 아래 level이 원본 mesh
+// rest length와 prolongation 가중치는 지금(변형된) 위치가 아니라 아래 level
+// edge의 rest length를 따라간 거리로 계산
+void BuildLevel(const ParticleState &particles,
+                const std::vector<uint32_t> *belowVertices,
+                const Graph &graph, const std::vector<uint32_t> &belowIndex0,
+                const std::vector<uint32_t> &belowIndex1,
+                const std::vector<float> &belowRestLength,
+                std::vector<int> &clusterOf,
+                std::vector<uint32_t> &representatives,
+                MultigridLevel &level) {
+    const uint32_t numBelow = uint32_t(clusterOf.size());
+    auto fineIndex = [&](uint32_t v) {
+        return belowVertices ? (*belowVertices)[v] : v;
+    };
+
+    // 1) clustering: 남은 vertex를 순서대로 대표로 삼고 1-ring을 묶음
+    for (uint32_t v = 0; v < numBelow; ++v) {
+        if (clusterOf[v] >= 0)
+            continue;
+        int c = int(representatives.size());
+        representatives.push_back(v);
+        clusterOf[v] = c;
+        for (uint32_t j = graph.offsets[v]; j < graph.offsets[v + 1]; ++j) {
+            if (clusterOf[graph.neighbors[j]] < 0)
+                clusterOf[graph.neighbors[j]] = c;
+        }
+    }
+
+    const size_t numClusters = representatives.size();
+    level.clusterOf = clusterOf;
+    level.vertices.resize(numClusters);
+    level.invMass.resize(numClusters);
+    for (size_t c = 0; c < numClusters; ++c) {
+        level.vertices[c] = fineIndex(representatives[c]);
+        level.invMass[c] = particles.invMass[level.vertices[c]];
+    }
+
+    // 아래 vertex에서 자기 cluster 대표까지 rest 거리 (cluster는 대표의
+    // 1-ring이므로 대부분 edge 하나, 두 번 완화해서 2단계 경로까지)
+    std::vector<float> toRepresentative(numBelow, FLT_MAX);
+    for (uint32_t r : representatives)
+        toRepresentative[r] = 0.0f;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (uint32_t v = 0; v < numBelow; ++v) {
+            for (uint32_t j = graph.offsets[v]; j < graph.offsets[v + 1];
+                 ++j) {
+                uint32_t n = graph.neighbors[j];
+                if (clusterOf[n] == clusterOf[v] &&
+                    toRepresentative[n] != FLT_MAX)
+                    toRepresentative[v] = std::min(
+                        toRepresentative[v],
+                        toRepresentative[n] + graph.lengths[j]);
+            }
+        }
+    }
+    for (float &d : toRepresentative)
+        if (d == FLT_MAX)
+            d = 0.0f;
+
+    // 2) 서로 다른 cluster를 잇는 edge마다 coarse edge 하나
+    // rest length = 대표 -> 아래 edge -> 대표 경로 중 가장 짧은 것
+    // 직선 거리보다 길거나 같으므로 아래 level이 rest 상태면 보정하지 않음
+    std::vector<std::pair<uint64_t, float>> keys;
+    keys.reserve(belowIndex0.size());
+    for (size_t e = 0; e < belowIndex0.size(); ++e) {
+        const uint32_t u = belowIndex0[e];
+        const uint32_t v = belowIndex1[e];
+        uint64_t a = uint64_t(clusterOf[u]);
+        uint64_t b = uint64_t(clusterOf[v]);
+        if (a != b)
+            keys.push_back({std::min(a, b) << 32 | std::max(a, b),
+                            toRepresentative[u] + belowRestLength[e] +
+                                toRepresentative[v]});
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [](const auto &x, const auto &y) {
+                               return x.first == y.first;
+                           }),
+               keys.end());
+
+    level.index0.resize(keys.size());
+    level.index1.resize(keys.size());
+    level.restLength.resize(keys.size());
+    for (size_t e = 0; e < keys.size(); ++e) {
+        level.index0[e] = uint32_t(keys[e].first >> 32);
+        level.index1[e] = uint32_t(keys[e].first & 0xffffffffu);
+        level.restLength[e] = keys[e].second; // 정렬 후 첫 항목이 최소
+    }
+
+    // 3) prolongation: 자기 cluster와 이웃 vertex의 cluster 대표로 보간
+    level.prolongOffsets.assign(numBelow + 1, 0);
+    level.prolongParents.clear();
+    level.prolongWeights.clear();
+    // 이웃 cluster 대표까지 거리는 이웃을 거친 rest 거리 중 최소
+    std::vector<uint32_t> parents;
+    std::vector<float> distances;
+    for (uint32_t v = 0; v < numBelow; ++v) {
+        parents.assign(1, uint32_t(clusterOf[v]));
+        distances.assign(1, toRepresentative[v]);
+        for (uint32_t j = graph.offsets[v]; j < graph.offsets[v + 1]; ++j) {
+            uint32_t n = graph.neighbors[j];
+            uint32_t c = uint32_t(clusterOf[n]);
+            float d = graph.lengths[j] + toRepresentative[n];
+            auto it = std::find(parents.begin(), parents.end(), c);
+            if (it == parents.end()) {
+                parents.push_back(c);
+                distances.push_back(d);
+            } else if (it != parents.begin()) {
+                float &old = distances[it - parents.begin()];
+                old = std::min(old, d);
+            }
+        }
+
+        float sum = 0.0f;
+        size_t first = level.prolongWeights.size();
+        for (size_t k = 0; k < parents.size(); ++k) {
+            float w = 1.0f / (distances[k] + WEIGHT_EPSILON);
+            level.prolongParents.push_back(parents[k]);
+            level.prolongWeights.push_back(w);
+            sum += w;
+        }
+        for (size_t j = first; j < level.prolongWeights.size(); ++j)
+            level.prolongWeights[j] /= sum;
+        level.prolongOffsets[v + 1] = uint32_t(level.prolongWeights.size());
+    }
+
+    level.x.resize(numClusters);
+    level.y.resize(numClusters);
+    level.z.resize(numClusters);
+    level.sx.resize(numClusters);
+    level.sy.resize(numClusters);
+    level.sz.resize(numClusters);
+}
+
+// 늘어난 coarse edge만 보정 (압축/굽힘은 원본 level에 맡김)
+void ProjectCoarseEdges(MultigridLevel &level, float stiffness) {
+    for (size_t e = 0; e < level.index0.size(); ++e) {
+        uint32_t a = level.index0[e];
+        uint32_t b = level.index1[e];
+        float dx = level.x[a] - level.x[b];
+        float dy = level.y[a] - level.y[b];
+        float dz = level.z[a] - level.z[b];
+        float len2 = dx * dx + dy * dy + dz * dz;
+        float w = level.invMass[a] + level.invMass[b];
+        if (len2 <= 1e-12f || w <= 0.0f)
+            continue;
+
+        float len = std::sqrt(len2);
+        float c = len - level.restLength[e];
+        if (c <= 0.0f)
+            continue;
+
+        float s = stiffness * c / (w * len);
+        float sa = level.invMass[a] * s;
+        float sb = level.invMass[b] * s;
+        level.x[a] -= sa * dx;
+        level.y[a] -= sa * dy;
+        level.z[a] -= sa * dz;
+        level.x[b] += sb * dx;
+        level.y[b] += sb * dy;
+        level.z[b] += sb * dz;
+    }
+}
+
+} // namespace
+
+int UpdateMultigridHierarchy(const ParticleState &particles,
+                             const std::vector<Edge> &edges,
+                             std::vector<MultigridLevel> &levels) {
+    const uint32_t numVertices = uint32_t(particles.Size());
+
+    std::vector<uint32_t> index0, index1;
+    std::vector<float> restLength;
+    index0.reserve(edges.size());
+    index1.reserve(edges.size());
+    restLength.reserve(edges.size());
+    for (const auto &e : edges) {
+        if (e.index0 == e.index1 || e.index0 >= numVertices ||
+            e.index1 >= numVertices)
+            continue;
+        index0.push_back(e.index0);
+        index1.push_back(e.index1);
+        restLength.push_back(e.restLength);
+    }
+
+    Graph graph;
+    BuildGraph(numVertices, index0, index1, restLength, graph);
+    std::vector<uint64_t> signatures(numVertices);
+    for (uint32_t v = 0; v < numVertices; ++v)
+        signatures[v] = Signature(graph, v);
+
+    // 이웃이 그대로인 vertex만으로 이루어진 cluster는 대표와 함께 유지
+    std::vector<int> clusterOf(numVertices, -1);
+    std::vector<uint32_t> representatives;
+    if (!levels.empty()) {
+        const MultigridLevel &old = levels[0];
+        const uint32_t oldCount =
+            std::min(numVertices, uint32_t(old.clusterOf.size()));
+
+        std::vector<char> changed(old.vertices.size(), 0);
+        for (uint32_t v = 0; v < oldCount; ++v) {
+            if (signatures[v] != old.belowSignatures[v])
+                changed[old.clusterOf[v]] = 1;
+        }
+        for (uint32_t v = oldCount; v < old.clusterOf.size(); ++v)
+            changed[old.clusterOf[v]] = 1; // 사라진 vertex
+
+        std::vector<int> remap(old.vertices.size(), -1);
+        for (size_t c = 0; c < old.vertices.size(); ++c) {
+            if (changed[c])
+                continue;
+            remap[c] = int(representatives.size());
+            representatives.push_back(old.vertices[c]);
+        }
+        for (uint32_t v = 0; v < oldCount; ++v)
+            clusterOf[v] = remap[old.clusterOf[v]];
+    }
+    const int reclustered =
+        int(std::count(clusterOf.begin(), clusterOf.end(), -1));
+
+    levels.clear();
+    if (numVertices < MIN_COARSE_VERTICES)
+        return reclustered;
+
+    MultigridLevel first;
+    BuildLevel(particles, nullptr, graph, index0, index1, restLength,
+               clusterOf, representatives, first);
+    if (first.vertices.size() > MAX_COARSE_RATIO * numVertices)
+        return reclustered;
+    first.belowSignatures = std::move(signatures);
+    levels.push_back(std::move(first));
+
+    while (int(levels.size()) < MAX_LEVELS &&
+           levels.back().vertices.size() >= MIN_COARSE_VERTICES) {
+        const MultigridLevel &below = levels.back();
+        Graph belowGraph;
+        BuildGraph(below.vertices.size(), below.index0, below.index1,
+                   below.restLength, belowGraph);
+
+        std::vector<int> belowClusterOf(below.vertices.size(), -1);
+        std::vector<uint32_t> belowRepresentatives;
+        MultigridLevel level;
+        BuildLevel(particles, &below.vertices, belowGraph, below.index0,
+                   below.index1, below.restLength, belowClusterOf,
+                   belowRepresentatives, level);
+        if (level.vertices.size() > MAX_COARSE_RATIO * below.vertices.size())
+            break;
+        levels.push_back(std::move(level));
+    }
+    return reclustered;
+}
+
+void SolveMultigridVCycle(ParticleState &particles,
+                          std::vector<MultigridLevel> &levels,
+                          int coarseIterations, float stiffness,
+                          int numThreads) {
+    if (levels.empty() || levels[0].clusterOf.size() != particles.Size())
+        return;
+
+    // 1) restriction: 모든 level에 대표 vertex의 예측 위치를 복사
+    for (auto &level : levels) {
+        for (size_t i = 0; i < level.vertices.size(); ++i) {
+            uint32_t f = level.vertices[i];
+            level.x[i] = level.sx[i] = particles.px[f];
+            level.y[i] = level.sy[i] = particles.py[f];
+            level.z[i] = level.sz[i] = particles.pz[f];
+        }
+    }
+
+    // 2) coarse -> fine: 풀고 나서 보정량을 아래 level로 보간
+    for (int l = int(levels.size()) - 1; l >= 0; --l) {
+        MultigridLevel &level = levels[l];
+        for (int i = 0; i < coarseIterations; ++i)
+            ProjectCoarseEdges(level, stiffness);
+
+        float *bx, *by, *bz;
+        const float *belowInvMass;
+        if (l == 0) {
+            bx = particles.px.data();
+            by = particles.py.data();
+            bz = particles.pz.data();
+            belowInvMass = particles.invMass.data();
+        } else {
+            MultigridLevel &below = levels[l - 1];
+            bx = below.x.data();
+            by = below.y.data();
+            bz = below.z.data();
+            belowInvMass = below.invMass.data();
+        }
+
+        ThreadPool::Get().ParallelFor(
+            0, int(level.clusterOf.size()), PROLONG_GRAIN_SIZE,
+            [&](int begin, int end) {
+                for (int v = begin; v < end; ++v) {
+                    if (belowInvMass[v] <= 0.0f)
+                        continue;
+                    float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+                    for (uint32_t j = level.prolongOffsets[v];
+                         j < level.prolongOffsets[v + 1]; ++j) {
+                        uint32_t p = level.prolongParents[j];
+                        float w = level.prolongWeights[j];
+                        dx += w * (level.x[p] - level.sx[p]);
+                        dy += w * (level.y[p] - level.sy[p]);
+                        dz += w * (level.z[p] - level.sz[p]);
+                    }
+                    bx[v] += dx;
+                    by[v] += dy;
+                    bz[v] += dz;
+                }
+            },
+            numThreads);
+    }
+}
+
+} // namespace jhm
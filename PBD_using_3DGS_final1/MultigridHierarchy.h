@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Edge.h"
+#include "ParticleState.h"
+
+namespace jhm {
+
+// Hierarchical PBD의 coarse level 하나
+// 이 level의 vertex는 바로 아래 level vertex의 부분집합 (cluster 대표)이고,
+// 위치는 항상 대표 vertex의 particle 위치에서 가져온다 (injection).
+struct MultigridLevel {
+    std::vector<uint32_t> vertices; // 대표 vertex의 particle 번호
+
+    // 아래 level vertex -> 이 level의 cluster 번호
+    std::vector<int> clusterOf;
+    // level 1 전용: 아래(원본) vertex의 이웃 signature. LineCut 후 바뀐
+    // vertex가 속한 cluster만 다시 만든다.
+    std::vector<uint64_t> belowSignatures;
+
+    // cluster 사이 distance constraint (늘어날 때만 보정)
+    std::vector<uint32_t> index0;
+    std::vector<uint32_t> index1;
+    std::vector<float> restLength;
+
+    // 아래 level vertex v의 보정량 =
+    //   sum(prolongWeights[j] * delta[prolongParents[j]]),
+    //   j = prolongOffsets[v] ~ prolongOffsets[v + 1]
+    std::vector<uint32_t> prolongOffsets;
+    std::vector<uint32_t> prolongParents;
+    std::vector<float> prolongWeights;
+
+    // V-cycle 작업 버퍼
+    AlignedVector<float> x, y, z;    // 보정 중인 위치
+    AlignedVector<float> sx, sy, sz; // restriction 직후 위치
+    AlignedVector<float> invMass;
+};
+
+// edge 그래프를 vertex clustering으로 줄여 coarse level 생성
+// levels가 비어 있으면 새로 만들고, 아니면 level 1에서 이웃이 바뀐 vertex의
+// cluster만 다시 만든 뒤 그 위 level을 다시 만든다 (LineCut 후).
+// coarse rest length와 prolongation 가중치는 edges의 restLength로만 계산하므로
+// 지금 변형된 위치는 coarse level의 rest 상태에 들어가지 않는다.
+// 다시 clustering한 원본 vertex 수 반환
+int UpdateMultigridHierarchy(const ParticleState &particles,
+                             const std::vector<Edge> &edges,
+                             std::vector<MultigridLevel> &levels);
+
+// 예측 위치(px, py, pz)에 V-cycle 한 번 적용
+// restriction으로 모든 level에 위치를 내려보낸 뒤, 가장 coarse한 level부터
+// coarseIterations번 Gauss-Seidel -> 보정량을 아래 level로 prolongation
+void SolveMultigridVCycle(ParticleState &particles,
+                          std::vector<MultigridLevel> &levels,
+                          int coarseIterations, float stiffness,
+                          int numThreads);
+
+} // namespace jhm
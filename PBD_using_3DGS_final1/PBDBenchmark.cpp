@@ -0,0 +1,1777 @@
+﻿#include "PBDBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include "BasicMeshGroup.h"
+#include "CpuFeatures.h"
+#include "GeometryGenerator.h"
+#include "MeshReordering.h"
+#include "SimulationScene.h"
+#include "ThreadPool.h"
+
+namespace jhm {
+
+using namespace std;
+
+namespace {
+
+const int BENCHMARK_FRAMES = 20;
+const int BENCHMARK_ITERATIONS = 5;
+const float BENCHMARK_DT = 1.0f / 60.0f;
+const float CONVERGENCE_TOLERANCE = 1e-3f;
+const int CONVERGENCE_MAX_ITERATIONS = 500;
+// substep benchmark에서 프레임당 constraint 반복 총 횟수
+const int SUBSTEP_BUDGET = 20;
+// 같은 XPBD compliance에서 Gauss-Seidel / Jacobi의 strain 비교
+const float COMPLIANCE_VALUES[] = {1e-5f, 1e-4f, 1e-3f, 1e-2f};
+const int COMPLIANCE_SUBSTEPS = 10;
+const int COMPLIANCE_ITERATIONS = 10;
+const int COMPLIANCE_FRAMES = 60;
+const int KERNEL_ITERATIONS = 5;
+const int VOLUME_REPEATS = 100;
+// 증분 부피 추적 benchmark: 호출마다 움직이는 vertex 비율 (번호 순 앞쪽)
+const float VOLUME_TRACKING_FRACTIONS[] = {0.0f, 0.001f, 0.01f, 0.1f, 1.0f};
+const int VOLUME_TRACKING_CALLS = 200;
+// early termination benchmark: 정지 상태에 도달할 때까지의 프레임 수
+const int EARLY_TERMINATION_FRAMES = 60;
+const int KERNEL_SWEEPS = 200;
+// SIMD kernel과 scalar kernel 결과 차이 허용치 (평균 edge 길이 대비)
+const float KERNEL_TOLERANCE = 1e-4f;
+// scene benchmark: 같은 메쉬를 solver만 바꿔 여러 그룹으로 등록
+const int SCENE_GROUPS = 4;
+const int SLEEP_FRAMES = 240;
+// multigrid benchmark 시작 상태: 중심 기준으로 전체를 늘림
+const float MULTIGRID_STRETCH = 1.1f;
+const int COLLISION_FRAMES = 60;
+// collider benchmark: SDF로 bake할 구의 반지름 / 격자 간격, 멀리 둔 collider 수
+const float SDF_SPHERE_RADIUS = 0.3f;
+const float SDF_CELL_SIZE = 0.02f;
+const int SDF_QUERY_REPEATS = 100;
+const int FAR_COLLIDERS = 16;
+const int COLLIDER_FRAMES = 120;
+const uint32_t SHUFFLE_SEED = 12345;
+// boundary particle benchmark: edge 길이 대비 particle 간격, 부풀리는 비율
+const float SAMPLING_SPACING = 0.25f;
+const float SAMPLING_SWELL = 0.3f;
+const int SAMPLING_FRAMES = 60;
+const int SAMPLING_CYCLES = 3; // slot 재사용을 확인할 부풀림 주기 수
+// compaction benchmark: slot을 흩뜨리는 부풀림 주기 수, 전후로 잴 프레임 수
+const int COMPACTION_CYCLES = 3;
+const int COMPACTION_FRAMES = 20;
+// barycentric benchmark: EvaluateParticles / UpdateParticles 반복 횟수
+const int BARYCENTRIC_REPEATS = 20;
+// resampling benchmark: 매 프레임 번갈아 늘이고 줄이는 비율, 그 프레임 수
+const float RESAMPLE_JITTER = 0.02f;
+const int RESAMPLE_JITTER_FRAMES = 40;
+// 생성 benchmark: MakeSphere(0.5, n, n)의 n
+const int TOPOLOGY_RESOLUTIONS[] = {64, 128, 256, 512, 1024};
+// half-edge benchmark: edge 전체를 훑어 1-ring을 찾는 vertex 수, split 횟수
+const int HALF_EDGE_SCAN_QUERIES = 16;
+const int HALF_EDGE_SPLITS = 1000;
+
+const char *SOLVER_NAMES[] = {"Gauss-Seidel", "Colored GS", "Jacobi",
+                               "Blocked GS"};
+
+struct SolverResult {
+    double distanceMs = 0.0; // ProjectDistanceConstraints 1회 평균
+    float maxStrain = 0.0f;
+    float rmsStrain = 0.0f;
+};
+
+void MeasureEdgeStrain(BasicMeshGroup &group, SolverResult &result) {
+    float maxStrain = 0.0f;
+    double sumSquared = 0.0;
+    size_t count = 0;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        MeshData &meshData = group.GetMeshData(m);
+        for (auto &e : meshData.edges) {
+            if (e.restLength <= 0.0f)
+                continue;
+            float l = (meshData.particles.Position(e.index0) -
+                       meshData.particles.Position(e.index1))
+                          .Length();
+            float strain = fabs(l - e.restLength) / e.restLength;
+            maxStrain = max(maxStrain, strain);
+            sumSquared += strain * strain;
+            ++count;
+        }
+    }
+    result.maxStrain = maxStrain;
+    result.rmsStrain = count > 0 ? float(sqrt(sumSquared / count)) : 0.0f;
+}
+
+SolverResult RunSolver(const vector<MeshData> &meshes, int solverType,
+                       int numThreads) {
+    BasicMeshGroup group;
+    group.InitializeSimulation(meshes);
+    group.m_solverType = solverType;
+    group.m_numThreads = numThreads;
+    // 부피를 키워서 constraint가 실제로 일을 하도록 함
+    group.m_volumePressure = 1.1f;
+
+    double distanceSeconds = 0.0;
+    for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame) {
+        group.ApplyExtForces(BENCHMARK_DT);
+        for (int i = 0; i < BENCHMARK_ITERATIONS; ++i) {
+            auto start = chrono::high_resolution_clock::now();
+            group.ProjectDistanceConstraints();
+            auto end = chrono::high_resolution_clock::now();
+            distanceSeconds += chrono::duration<double>(end - start).count();
+
+            group.SolveOverpressureConstraints();
+        }
+        group.Integrate(BENCHMARK_DT);
+    }
+
+    SolverResult result;
+    result.distanceMs =
+        distanceSeconds * 1000.0 / (BENCHMARK_FRAMES * BENCHMARK_ITERATIONS);
+    MeasureEdgeStrain(group, result);
+    return result;
+}
+
+// 예측 위치 기준 residual: max(edge strain RMS, 상대 부피 오차)
+float PredictedResidual(BasicMeshGroup &group) {
+    double sumSquared = 0.0;
+    size_t count = 0;
+    float volumeError = 0.0f;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        MeshData &meshData = group.GetMeshData(m);
+        const ParticleState &p = meshData.particles;
+        for (auto &e : meshData.edges) {
+            if (e.restLength <= 0.0f)
+                continue;
+            float l = (p.Predicted(e.index0) - p.Predicted(e.index1)).Length();
+            float strain = (l - e.restLength) / e.restLength;
+            sumSquared += strain * strain;
+            ++count;
+        }
+
+        float volume = 0.0f;
+        for (auto &t : meshData.triangles) {
+            volume += p.Predicted(t.vertexIndices[0])
+                          .Cross(p.Predicted(t.vertexIndices[1]))
+                          .Dot(p.Predicted(t.vertexIndices[2]));
+        }
+        float target = meshData.m_volume * group.m_volumePressure;
+        if (target != 0.0f)
+            volumeError = max(volumeError, fabs(volume / target - 1.0f));
+    }
+    float rmsStrain = count > 0 ? float(sqrt(sumSquared / count)) : 0.0f;
+    return max(rmsStrain, volumeError);
+}
+
+// 재현 가능한 의사 난수 [-1, 1]
+float Jitter(uint32_t seed) {
+    seed = (seed ^ 61u) ^ (seed >> 16);
+    seed *= 9u;
+    seed ^= seed >> 4;
+    seed *= 0x27d4eb2du;
+    seed ^= seed >> 15;
+    return float(seed & 0xffffff) / float(0x7fffff) - 1.0f;
+}
+
+float AverageEdgeLength(const MeshData &meshData) {
+    float avgLength = 0.0f;
+    for (auto &e : meshData.edges)
+        avgLength += e.restLength;
+    return avgLength / max(size_t(1), meshData.edges.size());
+}
+
+// 평균 edge 길이의 amount 배 만큼 예측 위치를 흐트러뜨림
+void JitterPredicted(BasicMeshGroup &group, float amount) {
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        MeshData &meshData = group.GetMeshData(m);
+        float scale = amount * AverageEdgeLength(meshData);
+
+        ParticleState &p = meshData.particles;
+        for (uint32_t i = 0; i < p.Size(); ++i) {
+            p.px[i] += Jitter(3 * i) * scale;
+            p.py[i] += Jitter(3 * i + 1) * scale;
+            p.pz[i] += Jitter(3 * i + 2) * scale;
+        }
+    }
+}
+
+// 평균 edge 길이 * SAMPLING_SPACING 간격으로 boundary particle sampling
+void SetSamplingDistance(BasicMeshGroup &group) {
+    double length = 0.0;
+    size_t numEdges = 0;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        const MeshData &meshData = group.GetMeshData(m);
+        for (const auto &e : meshData.edges)
+            length += e.restLength;
+        numEdges += meshData.edges.size();
+    }
+    group.m_particle_distance =
+        float(length / max<size_t>(1, numEdges)) * SAMPLING_SPACING;
+}
+
+vector<vector<Vector3>> GetRestPositions(BasicMeshGroup &group) {
+    vector<vector<Vector3>> rest(group.GetMeshCount());
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        const MeshData &meshData = group.GetMeshData(m);
+        for (size_t i = 0; i < meshData.particles.Size(); ++i)
+            rest[m].push_back(meshData.vertices[i].position);
+    }
+    return rest;
+}
+
+// 원점 기준으로 SAMPLING_FRAMES 주기로 부풀렸다 줄임 (frame이 주기의
+// 배수면 원래 크기)
+void SwellMesh(BasicMeshGroup &group, const vector<vector<Vector3>> &rest,
+               int frame) {
+    float scale =
+        1.0f + SAMPLING_SWELL * sinf(6.2831853f * frame / SAMPLING_FRAMES);
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        MeshData &meshData = group.GetMeshData(m);
+        for (size_t i = 0; i < rest[m].size(); ++i)
+            meshData.vertices[i].position = rest[m][i] * scale;
+    }
+}
+
+} // namespace
+
+void PBDBenchmark::RunConvergenceBenchmark(const string &name,
+                                           const vector<MeshData> &meshes) {
+    cout << "=== " << name << " convergence (tolerance "
+         << CONVERGENCE_TOLERANCE << ") ===" << endl;
+
+    for (int solverType : {PBD_SOLVER_GAUSS_SEIDEL,
+                           PBD_SOLVER_COLORED_GAUSS_SEIDEL, PBD_SOLVER_JACOBI}) {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        group.m_solverType = solverType;
+        group.ApplyExtForces(BENCHMARK_DT);
+        JitterPredicted(group, 0.2f);
+
+        float residual = PredictedResidual(group);
+        int iterations = 0;
+        auto start = chrono::high_resolution_clock::now();
+        while (residual > CONVERGENCE_TOLERANCE &&
+               iterations < CONVERGENCE_MAX_ITERATIONS) {
+            group.ProjectDistanceConstraints();
+            group.SolveOverpressureConstraints();
+            residual = PredictedResidual(group);
+            ++iterations;
+        }
+        auto end = chrono::high_resolution_clock::now();
+
+        cout << setw(14) << left << SOLVER_NAMES[solverType] << right << ": "
+             << iterations
+             << (iterations >= CONVERGENCE_MAX_ITERATIONS ? "+" : "")
+             << " iterations, residual " << residual << ", "
+             << chrono::duration<double, milli>(end - start).count() << " ms"
+             << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunMultigridBenchmark(const string &name,
+                                         const vector<MeshData> &meshes) {
+    using Clock = chrono::high_resolution_clock;
+
+    BasicMeshGroup base;
+    base.InitializeSimulation(meshes);
+    MeshData &meshData = base.GetMeshData(0);
+
+    cout << "=== " << name << " multigrid (levels";
+    cout << " " << meshData.particles.Size();
+    for (auto &level : meshData.multigridLevels)
+        cout << " > " << level.vertices.size();
+    cout << ") ===" << endl;
+
+    // 1) hierarchy 생성: 처음부터 / LineCut 후 바뀐 cluster만
+    vector<MultigridLevel> levels;
+    auto start = Clock::now();
+    UpdateMultigridHierarchy(meshData.particles, meshData.edges, levels);
+    double fullMs = chrono::duration<double, milli>(Clock::now() - start)
+                        .count();
+
+    // 늘어난 위치에서 다시 만들어도 coarse rest length가 그대로인지
+    ParticleState stretched = meshData.particles;
+    for (size_t i = 0; i < stretched.Size(); ++i)
+        stretched.SetPosition(i, stretched.Position(i) * MULTIGRID_STRETCH);
+    vector<MultigridLevel> stretchedLevels;
+    UpdateMultigridHierarchy(stretched, meshData.edges, stretchedLevels);
+    float restChange = 0.0f;
+    for (size_t l = 0; l < levels.size() && l < stretchedLevels.size(); ++l)
+        for (size_t e = 0; e < levels[l].restLength.size() &&
+                           e < stretchedLevels[l].restLength.size();
+             ++e)
+            restChange = max(restChange,
+                             fabsf(stretchedLevels[l].restLength[e] -
+                                   levels[l].restLength[e]) /
+                                 levels[l].restLength[e]);
+
+    vector<MultigridLevel> beforeCut = meshData.multigridLevels;
+    base.LineCut(Vector2(1.0f, 1.0f));
+    start = Clock::now();
+    int reclustered = UpdateMultigridHierarchy(meshData.particles,
+                                               meshData.edges, beforeCut);
+    double cutMs = chrono::duration<double, milli>(Clock::now() - start)
+                       .count();
+    levels.clear();
+    start = Clock::now();
+    UpdateMultigridHierarchy(meshData.particles, meshData.edges, levels);
+    double cutFullMs = chrono::duration<double, milli>(Clock::now() - start)
+                           .count();
+    cout << fixed << setprecision(3) << "build " << fullMs
+         << " ms, after LineCut: full " << cutFullMs << " ms, incremental "
+         << cutMs << " ms (" << reclustered << " / "
+         << meshData.particles.Size() << " vertices re-clustered)" << endl
+         << "coarse rest length change when rebuilt on a "
+         << MULTIGRID_STRETCH << "x stretched mesh: " << restChange << endl;
+
+    // 2) 반복 횟수별 residual: 전체를 고르게 늘린 위치에서 시작
+    const int iterationCounts[] = {1, 2, 5, 10, 20};
+    cout << "                ";
+    for (int n : iterationCounts)
+        cout << setw(9) << n;
+    cout << "  iterations" << endl;
+
+    for (bool multigrid : {false, true}) {
+        cout << (multigrid ? "Multigrid GS  " : "Flat GS       ") << "  "
+             << setprecision(5);
+        double seconds = 0.0;
+        int totalIterations = 0;
+        for (int n : iterationCounts) {
+            BasicMeshGroup group;
+            group.InitializeSimulation(meshes);
+            group.m_useMultigrid = multigrid;
+            group.m_numIterations = n;
+            group.ApplyExtForces(BENCHMARK_DT);
+            for (int m = 0; m < group.GetMeshCount(); ++m) {
+                ParticleState &p = group.GetMeshData(m).particles;
+                Vector3 center(0.0f);
+                for (size_t i = 0; i < p.Size(); ++i)
+                    center += p.Predicted(i);
+                center /= float(max<size_t>(1, p.Size()));
+                for (size_t i = 0; i < p.Size(); ++i)
+                    p.SetPredicted(i, center + (p.Predicted(i) - center) *
+                                                   MULTIGRID_STRETCH);
+            }
+
+            start = Clock::now();
+            for (int m = 0; m < group.GetMeshCount(); ++m)
+                group.SolveConstraints(group.GetMeshData(m));
+            seconds += chrono::duration<double>(Clock::now() - start).count();
+            totalIterations += n;
+
+            cout << setw(9) << PredictedResidual(group);
+        }
+        cout << setprecision(3) << "  " << seconds * 1000.0 / totalIterations
+             << " ms/iteration" << endl;
+    }
+    cout << defaultfloat << endl;
+}
+
+void PBDBenchmark::RunChebyshevBenchmark(const string &name,
+                                         const vector<MeshData> &meshes) {
+    cout << "=== " << name << " Chebyshev acceleration (residual) ==="
+         << endl;
+
+    const int iterationCounts[] = {1, 2, 5, 10, 20, 50};
+    cout << "                       ";
+    for (int n : iterationCounts)
+        cout << setw(9) << n;
+    cout << "  iterations" << endl;
+
+    for (int solverType : {PBD_SOLVER_GAUSS_SEIDEL, PBD_SOLVER_JACOBI}) {
+        for (bool chebyshev : {false, true}) {
+            cout << setw(14) << left << SOLVER_NAMES[solverType] << right
+                 << (chebyshev ? " Chebyshev" : "          ") << fixed
+                 << setprecision(5);
+
+            double seconds = 0.0;
+            int totalIterations = 0;
+            for (int n : iterationCounts) {
+                // 같은 흐트러진 위치에서 n번 반복
+                BasicMeshGroup group;
+                group.InitializeSimulation(meshes);
+                group.m_solverType = solverType;
+                group.m_useChebyshev = chebyshev;
+                group.m_numIterations = n;
+                group.ApplyExtForces(BENCHMARK_DT);
+                JitterPredicted(group, 0.2f);
+
+                auto start = chrono::high_resolution_clock::now();
+                for (int m = 0; m < group.GetMeshCount(); ++m)
+                    group.SolveConstraints(group.GetMeshData(m));
+                auto end = chrono::high_resolution_clock::now();
+                seconds += chrono::duration<double>(end - start).count();
+                totalIterations += n;
+
+                cout << setw(9) << PredictedResidual(group);
+            }
+            cout << setprecision(3) << "  "
+                 << seconds * 1000.0 / totalIterations << " ms/iteration"
+                 << defaultfloat << endl;
+        }
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunKernelBenchmark(const string &name,
+                                      const vector<MeshData> &meshes) {
+    size_t numEdges = 0;
+    for (const auto &m : meshes)
+        numEdges += m.edges.size();
+
+    const CpuFeatures &cpu = CpuFeatures::Get();
+    cout << "=== " << name << " distance kernels (SSE4.1 "
+         << (cpu.sse41 ? "yes" : "no") << ", AVX2 "
+         << (cpu.avx2 ? "yes" : "no") << ") ===" << endl;
+
+    // 흐트러뜨린 같은 입력에 대해 kernel별로 colored sweep을 반복
+    auto makeGroup = [&](BasicMeshGroup &group, DistanceKernelType kernel) {
+        group.InitializeSimulation(meshes);
+        group.m_solverType = PBD_SOLVER_COLORED_GAUSS_SEIDEL;
+        group.m_numThreads = 1;
+        group.m_distanceKernel = kernel;
+        group.ApplyExtForces(BENCHMARK_DT);
+        JitterPredicted(group, 0.2f);
+    };
+
+    BasicMeshGroup reference;
+    makeGroup(reference, DISTANCE_KERNEL_SCALAR);
+    for (int i = 0; i < KERNEL_ITERATIONS; ++i)
+        reference.ProjectDistanceConstraints();
+
+    for (DistanceKernelType kernel :
+         {DISTANCE_KERNEL_SCALAR, DISTANCE_KERNEL_SSE4, DISTANCE_KERNEL_AVX2}) {
+        if (ResolveDistanceKernel(kernel) != kernel) {
+            cout << setw(7) << left << GetDistanceKernelName(kernel) << right
+                 << ": not supported" << endl;
+            continue;
+        }
+
+        // 1) scalar 결과와 비교
+        BasicMeshGroup group;
+        makeGroup(group, kernel);
+        for (int i = 0; i < KERNEL_ITERATIONS; ++i)
+            group.ProjectDistanceConstraints();
+
+        float maxError = 0.0f;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            const ParticleState &a = group.GetMeshData(m).particles;
+            const ParticleState &b = reference.GetMeshData(m).particles;
+            float error = 0.0f;
+            for (size_t i = 0; i < a.Size(); ++i)
+                error = max(error, (a.Predicted(i) - b.Predicted(i)).Length());
+            maxError = max(maxError,
+                           error / AverageEdgeLength(group.GetMeshData(m)));
+        }
+
+        // 2) edges/second
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < KERNEL_SWEEPS; ++i)
+            group.ProjectDistanceConstraints();
+        auto end = chrono::high_resolution_clock::now();
+        double seconds = chrono::duration<double>(end - start).count();
+
+        cout << setw(7) << left << GetDistanceKernelName(kernel) << right
+             << ": " << scientific << setprecision(3)
+             << double(numEdges) * KERNEL_SWEEPS / seconds
+             << " edges/s, max error " << maxError << " ("
+             << (maxError <= KERNEL_TOLERANCE ? "PASS" : "FAIL") << ")"
+             << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunSubstepBenchmark(const string &name,
+                                       const vector<MeshData> &meshes) {
+    cout << "=== " << name << " XPBD substeps x iterations (budget "
+         << SUBSTEP_BUDGET << ") ===" << endl;
+
+    for (int numSubsteps : {1, 2, 4, 10, 20}) {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        group.m_volumePressure = 1.1f;
+        group.m_useXPBD = true;
+        group.m_numSubsteps = numSubsteps;
+        group.m_numIterations = SUBSTEP_BUDGET / numSubsteps;
+
+        auto start = chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+            group.Simulate(BENCHMARK_DT);
+        auto end = chrono::high_resolution_clock::now();
+
+        SolverResult result;
+        MeasureEdgeStrain(group, result);
+        cout << setw(2) << numSubsteps << " x " << setw(2)
+             << group.m_numIterations << " : " << fixed << setprecision(3)
+             << chrono::duration<double, milli>(end - start).count() /
+                    BENCHMARK_FRAMES
+             << " ms/frame, strain max " << result.maxStrain << " rms "
+             << result.rmsStrain << ", residual " << PredictedResidual(group)
+             << defaultfloat << endl;
+    }
+
+    // compliance가 solver와 무관하게 같은 뜻인지: 부피와 distance의
+    // compliance가 같으면 평형 strain은 compliance로 정해지므로 Jacobi와
+    // Gauss-Seidel의 strain이 같아야 함
+    for (float compliance : COMPLIANCE_VALUES) {
+        SolverResult results[2];
+        int s = 0;
+        for (int solverType : {PBD_SOLVER_GAUSS_SEIDEL, PBD_SOLVER_JACOBI}) {
+            BasicMeshGroup group;
+            group.InitializeSimulation(meshes);
+            group.m_volumePressure = 1.1f;
+            group.m_useXPBD = true;
+            group.m_solverType = solverType;
+            group.m_tolerance = 0.0f; // 반복 횟수를 같게
+            group.m_numSubsteps = COMPLIANCE_SUBSTEPS;
+            group.m_numIterations = COMPLIANCE_ITERATIONS;
+            group.m_distanceCompliance = compliance;
+            group.m_volumeCompliance = compliance;
+            for (int frame = 0; frame < COMPLIANCE_FRAMES; ++frame)
+                group.Simulate(BENCHMARK_DT);
+            MeasureEdgeStrain(group, results[s++]);
+        }
+        cout << "compliance " << compliance << " : strain rms Gauss-Seidel "
+             << fixed << setprecision(4) << results[0].rmsStrain
+             << ", Jacobi " << results[1].rmsStrain << " ("
+             << setprecision(2)
+             << results[1].rmsStrain / max(results[0].rmsStrain, 1e-9f)
+             << "x)" << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunEarlyTerminationBenchmark(
+    const string &name, const vector<MeshData> &meshes) {
+    cout << "=== " << name << " early termination (max "
+         << SUBSTEP_BUDGET << " iterations) ===" << endl;
+
+    for (float pressure : {1.0f, 1.1f}) {
+        for (bool earlyTermination : {false, true}) {
+            BasicMeshGroup group;
+            group.InitializeSimulation(meshes);
+            group.m_volumePressure = pressure;
+            group.m_numIterations = SUBSTEP_BUDGET;
+            group.m_earlyTermination = earlyTermination;
+            group.m_useSleep = false; // 정지 상태에서도 반복 횟수를 측정
+
+            // 뒤쪽 절반 (정지 상태) 프레임의 평균 반복 횟수와 시간
+            int iterations = 0;
+            double seconds = 0.0;
+            const int measured = EARLY_TERMINATION_FRAMES / 2;
+            for (int frame = 0; frame < EARLY_TERMINATION_FRAMES; ++frame) {
+                auto start = chrono::high_resolution_clock::now();
+                group.Simulate(BENCHMARK_DT);
+                auto end = chrono::high_resolution_clock::now();
+                if (frame >= EARLY_TERMINATION_FRAMES - measured) {
+                    iterations += group.GetResidual().iterations;
+                    seconds += chrono::duration<double>(end - start).count();
+                }
+            }
+
+            SolverResidual residual = group.GetResidual();
+            cout << "pressure " << fixed << setprecision(1) << pressure
+                 << (earlyTermination ? ", tolerance " : ", fixed     ")
+                 << setprecision(3) << ": " << float(iterations) / measured
+                 << " iterations/frame, " << seconds * 1000.0 / measured
+                 << " ms/frame, strain rms " << residual.rmsStrain
+                 << ", volume error " << residual.volumeError
+                 << defaultfloat << endl;
+        }
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunVolumeBenchmark(const string &name,
+                                      const vector<MeshData> &meshes) {
+    cout << "=== " << name << " volume constraint reduction ===" << endl;
+
+    vector<float> reference;
+    const int maxThreads = ThreadPool::Get().GetNumThreads();
+    for (int numThreads = 1;; numThreads = min(numThreads * 2, maxThreads)) {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        group.m_numThreads = numThreads;
+        group.m_volumePressure = 1.1f;
+        group.m_volumeTracking = VOLUME_TRACKING_FULL; // 매번 전체 합산
+        group.ApplyExtForces(BENCHMARK_DT);
+        JitterPredicted(group, 0.2f);
+
+        vector<float> scaling(group.GetMeshCount());
+        auto start = chrono::high_resolution_clock::now();
+        for (int i = 0; i < VOLUME_REPEATS; ++i) {
+            for (int m = 0; m < group.GetMeshCount(); ++m)
+                scaling[m] =
+                    group.computeVolumeConstraintScaling(group.GetMeshData(m));
+        }
+        auto end = chrono::high_resolution_clock::now();
+
+        // 1 스레드 결과와 비트 단위로 같은지 확인
+        if (reference.empty())
+            reference = scaling;
+        bool identical =
+            memcmp(reference.data(), scaling.data(),
+                   scaling.size() * sizeof(float)) == 0;
+
+        cout << setw(2) << numThreads << " threads : " << fixed
+             << setprecision(3)
+             << chrono::duration<double, milli>(end - start).count() /
+                    VOLUME_REPEATS
+             << " ms, " << (identical ? "bit-identical" : "DIFFERENT")
+             << defaultfloat << endl;
+        if (numThreads == maxThreads)
+            break;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunVolumeTrackingBenchmark(
+    const string &name, const vector<MeshData> &meshes) {
+    cout << "=== " << name << " incremental volume tracking ("
+         << VOLUME_TRACKING_CALLS << " calls) ===" << endl
+         << "  moved      full  incremental  speedup  scaling diff"
+            "     drift"
+         << endl
+         << "            (ms/call)" << endl;
+
+    for (float fraction : VOLUME_TRACKING_FRACTIONS) {
+        double modeMs[3] = {0.0, 0.0, 0.0};
+        vector<float> reference;
+        float maxDiff = 0.0f;
+        double maxDrift = 0.0;
+        for (int mode : {VOLUME_TRACKING_FULL, VOLUME_TRACKING_INCREMENTAL,
+                         VOLUME_TRACKING_VERIFY}) {
+            BasicMeshGroup group;
+            group.InitializeSimulation(meshes);
+            group.m_volumePressure = 1.1f;
+            group.m_volumeTracking = mode;
+            group.ApplyExtForces(BENCHMARK_DT);
+
+            // 호출마다 앞쪽 fraction 만큼의 vertex를 조금씩 움직임
+            vector<float> scaling;
+            for (int call = 0; call < VOLUME_TRACKING_CALLS; ++call) {
+                for (int m = 0; m < group.GetMeshCount(); ++m) {
+                    MeshData &meshData = group.GetMeshData(m);
+                    ParticleState &p = meshData.particles;
+                    const float scale = 0.01f * AverageEdgeLength(meshData);
+                    const uint32_t numMoved = uint32_t(fraction * p.Size());
+                    for (uint32_t i = 0; i < numMoved; ++i) {
+                        const uint32_t seed = (call * 3 + 1) * 7919 + 3 * i;
+                        p.px[i] += Jitter(seed) * scale;
+                        p.py[i] += Jitter(seed + 1) * scale;
+                        p.pz[i] += Jitter(seed + 2) * scale;
+                    }
+
+                    auto start = chrono::high_resolution_clock::now();
+                    scaling.push_back(
+                        group.computeVolumeConstraintScaling(meshData));
+                    auto end = chrono::high_resolution_clock::now();
+                    modeMs[mode] +=
+                        chrono::duration<double, milli>(end - start).count();
+                    maxDrift = max(maxDrift, group.m_volumeDrift);
+                }
+            }
+
+            if (mode == VOLUME_TRACKING_FULL) {
+                reference = scaling;
+                continue;
+            }
+            for (size_t i = 0; i < scaling.size(); ++i)
+                maxDiff = max(maxDiff, fabs(scaling[i] - reference[i]) /
+                                           max(fabs(reference[i]), 1e-30f));
+        }
+
+        const double calls = double(VOLUME_TRACKING_CALLS);
+        cout << setw(6) << fixed << setprecision(1) << fraction * 100.0f
+             << "%" << setprecision(3) << setw(10)
+             << modeMs[VOLUME_TRACKING_FULL] / calls << setw(13)
+             << modeMs[VOLUME_TRACKING_INCREMENTAL] / calls << setprecision(2)
+             << setw(8)
+             << modeMs[VOLUME_TRACKING_FULL] /
+                    modeMs[VOLUME_TRACKING_INCREMENTAL]
+             << "x" << defaultfloat << setprecision(3) << setw(14) << maxDiff
+             << setw(10) << maxDrift << endl;
+    }
+
+    // Incremental -> Full -> Incremental로 바꾼 뒤에도 캐시가 맞는지 (Verify)
+    BasicMeshGroup group;
+    group.InitializeSimulation(meshes);
+    group.m_volumePressure = 1.1f;
+    group.ApplyExtForces(BENCHMARK_DT);
+    double maxDrift = 0.0;
+    for (int call = 0; call < VOLUME_TRACKING_CALLS; ++call) {
+        const int third = call * 3 / VOLUME_TRACKING_CALLS;
+        group.m_volumeTracking = third == 0   ? VOLUME_TRACKING_INCREMENTAL
+                                 : third == 1 ? VOLUME_TRACKING_FULL
+                                              : VOLUME_TRACKING_VERIFY;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            MeshData &meshData = group.GetMeshData(m);
+            ParticleState &p = meshData.particles;
+            const float scale = 0.01f * AverageEdgeLength(meshData);
+            for (uint32_t i = 0; i < p.Size() / 100; ++i) {
+                const uint32_t seed = (call * 3 + 1) * 7919 + 3 * i;
+                p.px[i] += Jitter(seed) * scale;
+                p.py[i] += Jitter(seed + 1) * scale;
+                p.pz[i] += Jitter(seed + 2) * scale;
+            }
+            group.computeVolumeConstraintScaling(meshData);
+            if (group.m_volumeTracking == VOLUME_TRACKING_VERIFY)
+                maxDrift = max(maxDrift, group.m_volumeDrift);
+        }
+    }
+    cout << "Incremental -> Full -> Incremental: drift " << setprecision(3)
+         << maxDrift << defaultfloat
+         << endl
+         << endl;
+}
+
+void PBDBenchmark::RunSleepBenchmark(const string &name,
+                                     const vector<MeshData> &meshes) {
+    cout << "=== " << name << " sleep (" << SLEEP_FRAMES << " frames) ==="
+         << endl;
+
+    for (float pressure : {1.0f, 1.1f}) {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        group.m_volumePressure = pressure;
+
+        int sleepFrame = -1;
+        double awakeSeconds = 0.0, asleepSeconds = 0.0;
+        int numSleeping = 0, numIslands = 0;
+        for (int frame = 0; frame < SLEEP_FRAMES; ++frame) {
+            auto start = chrono::high_resolution_clock::now();
+            group.Simulate(BENCHMARK_DT);
+            group.GatherParticlePositions();
+            auto end = chrono::high_resolution_clock::now();
+            double seconds = chrono::duration<double>(end - start).count();
+
+            if (sleepFrame < 0) {
+                awakeSeconds += seconds;
+                group.GetIslandCount(numSleeping, numIslands);
+                if (numSleeping == numIslands)
+                    sleepFrame = frame;
+            } else {
+                asleepSeconds += seconds;
+            }
+        }
+
+        cout << "pressure " << fixed << setprecision(1) << pressure << " : "
+             << numIslands << " islands, ";
+        if (sleepFrame < 0) {
+            cout << "awake after " << SLEEP_FRAMES << " frames ("
+                 << setprecision(3) << awakeSeconds * 1000.0 / SLEEP_FRAMES
+                 << " ms/frame)" << defaultfloat << endl;
+            continue;
+        }
+        cout << "asleep at frame " << sleepFrame << ", " << setprecision(3)
+             << awakeSeconds * 1000.0 / (sleepFrame + 1)
+             << " ms/frame awake, "
+             << asleepSeconds * 1000.0 / (SLEEP_FRAMES - sleepFrame - 1)
+             << " ms/frame asleep";
+
+        // 압력을 바꾸면 다시 깨어나서 시뮬레이션해야 함
+        group.m_volumePressure = pressure + 0.1f;
+        group.Simulate(BENCHMARK_DT);
+        group.GetIslandCount(numSleeping, numIslands);
+        cout << ", pressure change -> "
+             << (numSleeping == 0 && group.GetResidual().iterations > 0
+                     ? "woke up"
+                     : "STILL ASLEEP")
+             << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunSelfCollisionBenchmark(const string &name,
+                                             const vector<MeshData> &meshes) {
+    cout << "=== " << name << " self collision (" << COLLISION_FRAMES
+         << " frames) ===" << endl;
+
+    for (bool selfCollision : {false, true}) {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        group.m_useSelfCollision = selfCollision;
+        group.m_useSleep = false;
+        // 바람을 빼고 위쪽 절반을 아래로 밀어서 위아래 면이 만나게 함
+        group.m_volumePressure = 0.8f;
+        size_t numParticles = 0;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            ParticleState &p = group.GetMeshData(m).particles;
+            float center = 0.0f;
+            for (size_t i = 0; i < p.Size(); ++i)
+                center += p.y[i];
+            center /= float(max<size_t>(1, p.Size()));
+            for (size_t i = 0; i < p.Size(); ++i) {
+                if (p.y[i] > center)
+                    p.vy[i] = -3.0f;
+            }
+            numParticles += p.Size();
+        }
+
+        double broadphaseMs = 0.0, narrowphaseMs = 0.0, frameMs = 0.0;
+        long long contacts = 0;
+        for (int frame = 0; frame < COLLISION_FRAMES; ++frame) {
+            auto start = chrono::high_resolution_clock::now();
+            group.Simulate(BENCHMARK_DT);
+            auto end = chrono::high_resolution_clock::now();
+            frameMs += chrono::duration<double, milli>(end - start).count();
+            broadphaseMs += group.m_broadphaseMs;
+            narrowphaseMs += group.m_narrowphaseMs;
+            contacts += group.m_numContacts;
+        }
+
+        // 최소 거리의 절반보다 가까운 (edge로 연결되지 않은) 쌍 = 겹침
+        size_t overlaps = 0;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            MeshData &meshData = group.GetMeshData(m);
+            ParticleState &p = meshData.particles;
+            float distance = group.GetSelfCollisionDistance(meshData);
+            SpatialHash hash;
+            vector<uint64_t> pairs;
+            hash.Build(p.x.data(), p.y.data(), p.z.data(), int(p.Size()),
+                       distance);
+            hash.FindPairs(0.5f * distance, &meshData.collisionFilter, pairs);
+            overlaps += pairs.size();
+        }
+
+        cout << (selfCollision ? "on  : " : "off : ") << fixed
+             << setprecision(3) << frameMs / COLLISION_FRAMES
+             << " ms/frame, overlapping pairs " << overlaps;
+        if (selfCollision) {
+            cout << ", contacts/frame " << contacts / COLLISION_FRAMES
+                 << ", broadphase " << broadphaseMs / COLLISION_FRAMES
+                 << " ms, narrowphase " << narrowphaseMs / COLLISION_FRAMES
+                 << " ms ("
+                 << (broadphaseMs + narrowphaseMs) * 1e6 /
+                        (double(COLLISION_FRAMES) * numParticles)
+                 << " ns/particle)";
+        }
+        cout << defaultfloat << endl;
+    }
+
+    // 자른 직후 같은 위치에 생긴 vertex 쌍(잘린 면 양쪽)이 filter에 빠지지
+    // 않고 충돌 대상으로 남는지
+    BasicMeshGroup group;
+    group.InitializeSimulation(meshes);
+    vector<size_t> oldCounts;
+    for (int m = 0; m < group.GetMeshCount(); ++m)
+        oldCounts.push_back(group.GetMeshData(m).particles.Size());
+    group.LineCut(Vector2(1.0f, 1.0f));
+    size_t seamPairs = 0, collidingPairs = 0;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        MeshData &meshData = group.GetMeshData(m);
+        ParticleState &p = meshData.particles;
+        const float distance = 1e-3f * meshData.averageEdgeLength;
+        SpatialHash hash;
+        vector<uint64_t> all, colliding;
+        hash.Build(p.x.data(), p.y.data(), p.z.data(), int(p.Size()),
+                   meshData.averageEdgeLength);
+        hash.FindPairs(distance, nullptr, all);
+        hash.FindPairs(distance, &meshData.collisionFilter, colliding);
+        auto isNew = [&](uint64_t key) {
+            return (key & 0xffffffffu) >= oldCounts[m];
+        };
+        seamPairs += count_if(all.begin(), all.end(), isNew);
+        collidingPairs += count_if(colliding.begin(), colliding.end(), isNew);
+    }
+    cout << "after LineCut: " << collidingPairs << " / " << seamPairs
+         << " coincident pairs with a new vertex can collide" << endl
+         << endl;
+}
+
+void PBDBenchmark::RunColliderBenchmark(const string &name,
+                                        const vector<MeshData> &meshes) {
+    cout << "=== " << name << " static colliders ===" << endl;
+
+    // 1) SDF bake / batch query (해석적인 구 거리와 비교)
+    MeshData sdfMesh =
+        GeometryGenerator::MakeSphere(SDF_SPHERE_RADIUS, 64, 64);
+    SdfGrid sdf;
+    auto start = chrono::high_resolution_clock::now();
+    sdf.Bake(sdfMesh, SDF_CELL_SIZE, 4.0f * SDF_CELL_SIZE);
+    double bakeMs = chrono::duration<double, milli>(
+                        chrono::high_resolution_clock::now() - start)
+                        .count();
+
+    // 메쉬 particle의 (중심 기준) 방향으로 SDF 구 표면 안팎에 query 배치
+    AlignedVector<float> qx, qy, qz;
+    for (const auto &meshData : meshes) {
+        const ParticleState &p = meshData.particles;
+        Vector3 center(0.0f);
+        for (size_t i = 0; i < p.Size(); ++i)
+            center += p.Position(i);
+        center /= float(max<size_t>(1, p.Size()));
+        for (size_t i = 0; i < p.Size(); ++i) {
+            Vector3 dir = p.Position(i) - center;
+            dir.Normalize();
+            dir *= SDF_SPHERE_RADIUS * (0.5f + 0.1f * float(i % 11));
+            qx.push_back(dir.x);
+            qy.push_back(dir.y);
+            qz.push_back(dir.z);
+        }
+    }
+    const int numQueries = int(qx.size());
+    AlignedVector<float> distance(numQueries), gx(numQueries), gy(numQueries),
+        gz(numQueries);
+    start = chrono::high_resolution_clock::now();
+    for (int r = 0; r < SDF_QUERY_REPEATS; ++r)
+        sdf.Sample(qx.data(), qy.data(), qz.data(), numQueries,
+                   distance.data(), gx.data(), gy.data(), gz.data());
+    double queryMs = chrono::duration<double, milli>(
+                         chrono::high_resolution_clock::now() - start)
+                         .count();
+
+    // 다각형 구와 해석적 구의 차이도 포함된 오차 (격자 안의 위치만)
+    ColliderAabb grid = sdf.GetAabb();
+    float maxError = 0.0f;
+    for (int i = 0; i < numQueries; ++i) {
+        if (qx[i] < grid.min.x || qy[i] < grid.min.y || qz[i] < grid.min.z ||
+            qx[i] > grid.max.x || qy[i] > grid.max.y || qz[i] > grid.max.z)
+            continue;
+        float exact = sqrt(qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]) -
+                      SDF_SPHERE_RADIUS;
+        maxError = max(maxError, fabs(distance[i] - exact));
+    }
+    cout << "SDF " << sdf.GetCellCount() << " cells, bake " << fixed
+         << setprecision(1) << bakeMs << " ms, "
+         << (CpuFeatures::Get().avx2 ? "AVX2" : "scalar") << " query "
+         << setprecision(2)
+         << queryMs * 1e6 / (double(SDF_QUERY_REPEATS) * numQueries)
+         << " ns/particle (" << numQueries << " particles: "
+         << queryMs * 1e3 / SDF_QUERY_REPEATS << " us), max error "
+         << setprecision(4) << maxError / SDF_CELL_SIZE << " cells"
+         << defaultfloat << endl;
+
+    // 2) 바닥 평면 + capsule + SDF 구 위로 떨어뜨림, 멀리 있는 collider는
+    //    broadphase에서 빠져야 함
+    BasicMeshGroup group;
+    group.InitializeSimulation(meshes);
+    group.m_gravity = 9.8f;
+    group.m_numSubsteps = 2;
+
+    ColliderAabb bounds;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        const ParticleState &p = group.GetMeshData(m).particles;
+        for (size_t i = 0; i < p.Size(); ++i) {
+            bounds.min = Vector3::Min(bounds.min, p.Position(i));
+            bounds.max = Vector3::Max(bounds.max, p.Position(i));
+        }
+    }
+    Vector3 center = (bounds.min + bounds.max) * 0.5f;
+    float radius = (bounds.max - bounds.min).Length() * 0.5f;
+    float floor = bounds.min.y - 1.5f * radius;
+
+    SimulationScene scene;
+    scene.Register(&group);
+    ColliderSet &colliders = scene.GetColliders();
+    colliders.AddPlane(Vector3(0.0f, 1.0f, 0.0f), floor);
+    // 메쉬 바로 아래의 가로 막대
+    float barY = bounds.min.y - 0.5f * radius;
+    colliders.AddCapsule(Vector3(center.x - radius, barY, center.z),
+                         Vector3(center.x + radius, barY, center.z),
+                         0.1f * radius);
+    for (auto &v : sdfMesh.vertices)
+        v.position = v.position * (radius / SDF_SPHERE_RADIUS * 0.5f) +
+                     Vector3(center.x + 0.5f * radius, floor, center.z);
+    SdfGrid floorSdf;
+    floorSdf.Bake(sdfMesh, SDF_CELL_SIZE * radius / SDF_SPHERE_RADIUS,
+                  0.2f * radius);
+    colliders.AddSdf(std::move(floorSdf));
+    for (int c = 0; c < FAR_COLLIDERS; ++c)
+        colliders.AddSphere(center + Vector3(100.0f * radius * (c + 1), 0.0f,
+                                             0.0f),
+                            radius);
+
+    double frameMs = 0.0, colliderMs = 0.0;
+    long long candidates = 0, contacts = 0;
+    for (int f = 0; f < COLLIDER_FRAMES; ++f) {
+        scene.Step(BENCHMARK_DT);
+        frameMs += scene.GetStepTimeMs();
+        colliderMs += group.m_colliderMs;
+        candidates += group.m_numColliderCandidates;
+        contacts += group.m_numColliderContacts;
+    }
+
+    // 바닥 아래로 들어간 깊이 (margin 기준)
+    float penetration = 0.0f;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        const ParticleState &p = group.GetMeshData(m).particles;
+        for (size_t i = 0; i < p.Size(); ++i)
+            penetration = max(penetration, floor - p.y[i]);
+    }
+    cout << "drop " << COLLIDER_FRAMES << " frames: " << fixed
+         << setprecision(3) << frameMs / COLLIDER_FRAMES
+         << " ms/frame, colliders " << colliderMs / COLLIDER_FRAMES
+         << " ms/frame, broadphase candidates/frame " << setprecision(1)
+         << double(candidates) / COLLIDER_FRAMES << " of "
+         << colliders.GetCount() << " colliders x " << group.m_numSubsteps
+         << " substeps, contacts/frame " << contacts / COLLIDER_FRAMES
+         << ", max floor penetration " << setprecision(5) << penetration
+         << defaultfloat << endl
+         << endl;
+}
+
+void PBDBenchmark::RunReorderBenchmark(const string &name,
+                                       const vector<MeshData> &meshes) {
+    cout << "=== " << name << " vertex reordering ===" << endl;
+    cout << "order      reorder   edge span   Gauss-Seidel   Colored GS"
+            "       Jacobi  (ms/sweep)"
+         << endl;
+
+    const char *rows[] = {"input", "shuffled", "Morton", "RCM"};
+    for (int row = 0; row < 4; ++row) {
+        vector<MeshData> ordered = meshes;
+        double reorderMs = 0.0;
+        for (auto &meshData : ordered) {
+            if (row == 1) {
+                // 로더가 vertex를 아무 순서로나 내보내는 경우
+                vector<uint32_t> order(meshData.vertices.size());
+                iota(order.begin(), order.end(), 0u);
+                shuffle(order.begin(), order.end(), mt19937(SHUFFLE_SEED));
+                ApplyVertexOrder(meshData, order);
+            } else if (row >= 2) {
+                auto start = chrono::high_resolution_clock::now();
+                ReorderMesh(meshData, row == 2 ? MESH_ORDER_MORTON
+                                               : MESH_ORDER_RCM);
+                reorderMs += chrono::duration<double, milli>(
+                                 chrono::high_resolution_clock::now() - start)
+                                 .count();
+            }
+        }
+
+        // edge 양 끝 vertex 번호 차이의 평균
+        double span = 0.0;
+        size_t numEdges = 0;
+        for (const auto &meshData : ordered) {
+            for (const auto &e : meshData.edges)
+                span += double(e.index1) - double(e.index0);
+            numEdges += meshData.edges.size();
+        }
+
+        cout << setw(8) << left << rows[row] << right << fixed
+             << setprecision(2) << setw(9) << reorderMs << " ms"
+             << setprecision(1) << setw(10) << span / max<size_t>(1, numEdges)
+             << setprecision(3);
+        for (int solverType : {PBD_SOLVER_GAUSS_SEIDEL,
+                               PBD_SOLVER_COLORED_GAUSS_SEIDEL,
+                               PBD_SOLVER_JACOBI})
+            cout << setw(13) << RunSolver(ordered, solverType, 0).distanceMs;
+        cout << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunBlockedBenchmark(const string &name,
+                                       const vector<MeshData> &meshes) {
+    size_t numEdges = 0, numBorderEdges = 0, numBlocks = 0;
+    {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            const MeshData &meshData = group.GetMeshData(m);
+            size_t blocks = meshData.blockEdgeOffsets.size() - 1;
+            numBlocks += blocks;
+            numEdges += meshData.blockedIndex0.size();
+            numBorderEdges += meshData.blockedIndex0.size() -
+                              meshData.blockEdgeOffsets[blocks];
+        }
+    }
+    cout << "=== " << name << " cache-blocked Gauss-Seidel (" << numBlocks
+         << " blocks, " << fixed << setprecision(1)
+         << 100.0 * numBorderEdges / max<size_t>(1, numEdges)
+         << "% border edges) ===" << defaultfloat << endl;
+
+    const int iterationCounts[] = {1, 2, 5, 10};
+    cout << "                       ";
+    for (int n : iterationCounts)
+        cout << setw(9) << n;
+    cout << "  iterations" << endl;
+
+    struct Row {
+        int solverType;
+        int blockIterations;
+    };
+    const Row rows[] = {{PBD_SOLVER_GAUSS_SEIDEL, 0},
+                        {PBD_SOLVER_COLORED_GAUSS_SEIDEL, 0},
+                        {PBD_SOLVER_BLOCKED_GAUSS_SEIDEL, 1},
+                        {PBD_SOLVER_BLOCKED_GAUSS_SEIDEL, 2},
+                        {PBD_SOLVER_BLOCKED_GAUSS_SEIDEL, 4}};
+    for (const Row &row : rows) {
+        cout << setw(14) << left << SOLVER_NAMES[row.solverType] << right;
+        if (row.blockIterations > 0)
+            cout << " local x" << row.blockIterations << " ";
+        else
+            cout << "          ";
+        cout << fixed << setprecision(5);
+
+        double seconds = 0.0;
+        int totalIterations = 0;
+        for (int n : iterationCounts) {
+            // 같은 흐트러진 위치에서 n번 반복
+            BasicMeshGroup group;
+            group.InitializeSimulation(meshes);
+            group.m_solverType = row.solverType;
+            group.m_blockIterations = row.blockIterations;
+            group.m_numIterations = n;
+            group.ApplyExtForces(BENCHMARK_DT);
+            JitterPredicted(group, 0.2f);
+
+            auto start = chrono::high_resolution_clock::now();
+            for (int m = 0; m < group.GetMeshCount(); ++m)
+                group.SolveConstraints(group.GetMeshData(m));
+            auto end = chrono::high_resolution_clock::now();
+            seconds += chrono::duration<double>(end - start).count();
+            totalIterations += n;
+
+            cout << setw(9) << PredictedResidual(group);
+        }
+        cout << setprecision(3) << "  " << seconds * 1000.0 / totalIterations
+             << " ms/iteration" << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunSamplingBenchmark(const string &name,
+                                        const vector<MeshData> &meshes) {
+    using Clock = chrono::high_resolution_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+    cout << "=== " << name << " boundary particle sampling ===" << endl;
+
+    vector<float> reference;
+    double serialUpdateMs = 0.0;
+    const int maxThreads = ThreadPool::Get().GetNumThreads();
+    for (int numThreads = 1;; numThreads = min(numThreads * 2, maxThreads)) {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        group.m_numThreads = numThreads;
+        group.m_compactionThreshold = 0.0f; // slot 재사용만 확인
+        SetSamplingDistance(group);
+
+        auto start = Clock::now();
+        group.InitParticles();
+        auto initialized = Clock::now();
+
+        size_t numSamples = 0;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            const MeshData &meshData = group.GetMeshData(m);
+            numSamples += meshData.vertices.size() - meshData.particles.Size();
+        }
+
+        // 부풀렸다 줄이면서 edge / 내부 particle을 다시 sampling
+        // 주기마다 vertex slot 수를 기록해 반납된 slot이 재사용되는지 확인
+        auto rest = GetRestPositions(group);
+        double updateMs = 0.0;
+        vector<size_t> cycleSlots;
+        for (int frame = 1; frame <= SAMPLING_FRAMES * SAMPLING_CYCLES;
+             ++frame) {
+            SwellMesh(group, rest, frame);
+            auto frameStart = Clock::now();
+            group.UpdateParticles();
+            updateMs += ms(frameStart, Clock::now());
+            if (frame % SAMPLING_FRAMES == 0) {
+                cycleSlots.push_back(0);
+                for (int m = 0; m < group.GetMeshCount(); ++m)
+                    cycleSlots.back() += group.GetMeshData(m).vertices.size();
+            }
+        }
+        bool bounded = true, equal = true;
+        for (size_t cycleSlot : cycleSlots) {
+            bounded = bounded && cycleSlot <= cycleSlots[0];
+            equal = equal && cycleSlot == cycleSlots[0];
+        }
+        size_t live = 0, drawn = 0;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            const MeshData &meshData = group.GetMeshData(m);
+            live += meshData.vertices.size() - meshData.freeParticles.size() -
+                    meshData.particles.Size();
+            drawn += meshData.indices.size() - meshData.triangles.size() * 3;
+        }
+
+        // sample 번호와 위치가 1 스레드 결과와 비트 단위로 같은지 확인
+        vector<float> positions;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            for (const auto &v : group.GetMeshData(m).vertices) {
+                positions.push_back(v.position.x);
+                positions.push_back(v.position.y);
+                positions.push_back(v.position.z);
+                positions.push_back(v.scale.x);
+            }
+        }
+        if (reference.empty()) {
+            reference = positions;
+            serialUpdateMs = updateMs;
+        }
+        bool identical =
+            positions.size() == reference.size() &&
+            memcmp(positions.data(), reference.data(),
+                   positions.size() * sizeof(float)) == 0;
+
+        cout << setw(2) << numThreads << " threads : " << numSamples
+             << " samples, InitParticles " << fixed << setprecision(3)
+             << ms(start, initialized) << " ms, UpdateParticles "
+             << updateMs / (SAMPLING_FRAMES * SAMPLING_CYCLES)
+             << " ms/frame, speedup "
+             << setprecision(2) << serialUpdateMs / updateMs << "x, "
+             << (identical ? "bit-identical" : "DIFFERENT") << defaultfloat
+             << endl;
+        cout << "   vertex slots per cycle";
+        for (size_t cycleSlot : cycleSlots)
+            cout << " " << cycleSlot;
+        cout << " ("
+             << (equal     ? "equal to"
+                 : bounded ? "bounded by"
+                           : "EXCEEDS")
+             << " cycle 1), live samples " << live << ", drawn " << drawn
+             << endl;
+
+        // mesh 데이터 복사 / 해제
+        if (numThreads == 1) {
+            auto copyStart = Clock::now();
+            vector<MeshData> copies;
+            for (int m = 0; m < group.GetMeshCount(); ++m)
+                copies.push_back(group.GetMeshData(m));
+            auto copied = Clock::now();
+            copies.clear();
+            auto destroyed = Clock::now();
+            cout << "   MeshData copy " << fixed << setprecision(3)
+                 << ms(copyStart, copied) << " ms, free "
+                 << ms(copied, destroyed) << " ms" << defaultfloat << endl;
+        }
+        if (numThreads == maxThreads)
+            break;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunCompactionBenchmark(const string &name,
+                                          const vector<MeshData> &meshes) {
+    using Clock = chrono::high_resolution_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+    cout << "=== " << name << " boundary particle compaction ===" << endl;
+
+    auto countSlots = [](BasicMeshGroup &group, size_t &slots, size_t &live) {
+        slots = live = 0;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            const MeshData &meshData = group.GetMeshData(m);
+            slots += meshData.vertices.size() - meshData.particles.Size();
+            live += meshData.vertices.size() - meshData.particles.Size() -
+                    meshData.freeParticles.size();
+        }
+    };
+    // 원래 크기에서 다시 sampling (모든 particle 위치를 다시 씀)
+    auto measureUpdate = [&](BasicMeshGroup &group) {
+        auto start = Clock::now();
+        for (int i = 0; i < COMPACTION_FRAMES; ++i)
+            group.UpdateParticles();
+        return ms(start, Clock::now()) / COMPACTION_FRAMES;
+    };
+
+    // 자동 compaction 없이 여러 주기를 돌려 slot을 흩뜨림
+    BasicMeshGroup group;
+    group.InitializeSimulation(meshes);
+    group.m_compactionThreshold = 0.0f;
+    SetSamplingDistance(group);
+    group.InitParticles();
+    auto rest = GetRestPositions(group);
+    for (int frame = 1; frame <= SAMPLING_FRAMES * COMPACTION_CYCLES; ++frame) {
+        SwellMesh(group, rest, frame);
+        group.UpdateParticles();
+    }
+
+    size_t slots, live;
+    countSlots(group, slots, live);
+    double fragmentedMs = measureUpdate(group);
+    cout << "  after " << COMPACTION_CYCLES << " swell cycles: " << live
+         << " live / " << slots << " slots (fragmentation " << fixed
+         << setprecision(2) << 1.0 - double(live) / max<size_t>(1, slots)
+         << "), UpdateParticles "
+         << setprecision(3) << fragmentedMs << " ms" << endl;
+
+    group.CompactParticles();
+    countSlots(group, slots, live);
+    double compactedMs = measureUpdate(group);
+
+    // 모든 particle이 정확히 한 번씩 그려지고 slot이 빈틈 없는지
+    bool valid = slots == live;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        const MeshData &meshData = group.GetMeshData(m);
+        const size_t base = meshData.particles.Size();
+        vector<char> drawn(meshData.vertices.size() - base, 0);
+        for (size_t i = meshData.triangles.size() * 3;
+             i < meshData.indices.size(); ++i) {
+            const uint32_t index = meshData.indices[i];
+            if (index < base || index >= meshData.vertices.size() ||
+                drawn[index - base]++)
+                valid = false;
+        }
+        for (char d : drawn)
+            valid = valid && d;
+    }
+    cout << "  compacted: " << live << " live / " << slots
+         << " slots, reclaimed " << setprecision(1)
+         << group.m_compactionBytes / 1024.0 << " KB in " << setprecision(3)
+         << group.m_compactionMs << " ms, UpdateParticles " << compactedMs
+         << " ms (" << setprecision(2) << fragmentedMs / compactedMs
+         << "x), " << (valid ? "valid" : "INVALID") << defaultfloat << endl;
+
+    // 기본 threshold로 자동 compaction
+    BasicMeshGroup automatic;
+    automatic.InitializeSimulation(meshes);
+    SetSamplingDistance(automatic);
+    automatic.InitParticles();
+    auto start = Clock::now();
+    for (int frame = 1; frame <= SAMPLING_FRAMES * COMPACTION_CYCLES; ++frame) {
+        SwellMesh(automatic, rest, frame);
+        automatic.UpdateParticles();
+    }
+    double automaticMs = ms(start, Clock::now());
+    countSlots(automatic, slots, live);
+    cout << "  automatic (threshold " << automatic.m_compactionThreshold
+         << "): " << automatic.m_numCompactions << " compactions, " << live
+         << " live / " << slots << " slots, " << fixed << setprecision(3)
+         << automaticMs / (SAMPLING_FRAMES * COMPACTION_CYCLES)
+         << " ms/frame" << defaultfloat << endl
+         << endl;
+}
+
+void PBDBenchmark::RunBarycentricBenchmark(const string &name,
+                                           const vector<MeshData> &meshes) {
+    using Clock = chrono::high_resolution_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+
+    BasicMeshGroup group;
+    group.InitializeSimulation(meshes);
+    SetSamplingDistance(group);
+    group.InitParticles();
+
+    size_t numParticles = 0;
+    for (int m = 0; m < group.GetMeshCount(); ++m) {
+        const MeshData &meshData = group.GetMeshData(m);
+        numParticles += meshData.vertices.size() - meshData.particles.Size();
+    }
+    cout << "=== " << name << " barycentric particles (" << numParticles
+         << " particles) ===" << endl;
+
+    // scalar kernel 결과 (위치, normal)
+    auto gather = [&]() {
+        vector<Vector3> result;
+        for (int m = 0; m < group.GetMeshCount(); ++m) {
+            const MeshData &meshData = group.GetMeshData(m);
+            for (size_t i = meshData.particles.Size();
+                 i < meshData.vertices.size(); ++i) {
+                result.push_back(meshData.vertices[i].position);
+                result.push_back(meshData.vertices[i].normal);
+            }
+        }
+        return result;
+    };
+    group.m_particleKernel = DISTANCE_KERNEL_SCALAR;
+    for (int m = 0; m < group.GetMeshCount(); ++m)
+        group.EvaluateParticles(group.GetMeshData(m));
+    const vector<Vector3> reference = gather();
+    const float edgeLength = AverageEdgeLength(group.GetMeshData(0));
+
+    for (DistanceKernelType kernel :
+         {DISTANCE_KERNEL_SCALAR, DISTANCE_KERNEL_AVX2}) {
+        if (ResolveDistanceKernel(kernel) != kernel) {
+            cout << setw(7) << left << GetDistanceKernelName(kernel) << right
+                 << ": not supported" << endl;
+            continue;
+        }
+        group.m_particleKernel = kernel;
+        auto start = Clock::now();
+        for (int i = 0; i < BARYCENTRIC_REPEATS; ++i)
+            for (int m = 0; m < group.GetMeshCount(); ++m)
+                group.EvaluateParticles(group.GetMeshData(m));
+        double evaluateMs = ms(start, Clock::now()) / BARYCENTRIC_REPEATS;
+
+        // 위치는 평균 edge 길이, normal은 1 대비 차이
+        const vector<Vector3> result = gather();
+        float maxError = 0.0f;
+        for (size_t i = 0; i < result.size(); ++i)
+            maxError = max(maxError, (result[i] - reference[i]).Length() /
+                                         (i % 2 ? 1.0f : edgeLength));
+
+        cout << setw(7) << left << GetDistanceKernelName(kernel) << right
+             << ": EvaluateParticles " << fixed << setprecision(3)
+             << evaluateMs << " ms (" << setprecision(1)
+             << evaluateMs * 1e6 / max<size_t>(1, numParticles)
+             << " ns/particle), max error " << scientific << setprecision(3)
+             << maxError << " ("
+             << (maxError <= KERNEL_TOLERANCE ? "PASS" : "FAIL") << ")"
+             << defaultfloat << endl;
+    }
+
+    // 구조가 바뀌지 않는 프레임: 분류만 하고 resampling 없음
+    group.m_particleKernel = DISTANCE_KERNEL_AUTO;
+    auto start = Clock::now();
+    for (int i = 0; i < BARYCENTRIC_REPEATS; ++i)
+        group.UpdateParticles();
+    cout << "UpdateParticles without resampling " << fixed << setprecision(3)
+         << ms(start, Clock::now()) / BARYCENTRIC_REPEATS << " ms/frame"
+         << defaultfloat << endl
+         << endl;
+}
+
+void PBDBenchmark::RunResampleBenchmark(const string &name,
+                                        const vector<MeshData> &meshes) {
+    using Clock = chrono::high_resolution_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return chrono::duration<double, milli>(b - a).count();
+    };
+    cout << "=== " << name << " lazy resampling ===" << endl;
+
+    struct Config {
+        float hysteresis;
+        int budget;
+    };
+    const int defaultBudget = BasicMeshGroup().m_resampleBudget;
+    for (Config config : {Config{0.0f, 0}, Config{0.25f, 0},
+                          Config{0.25f, defaultBudget}}) {
+        BasicMeshGroup group;
+        group.InitializeSimulation(meshes);
+        group.m_compactionThreshold = 0.0f;
+        group.m_resampleHysteresis = config.hysteresis;
+        group.m_resampleBudget = config.budget;
+        SetSamplingDistance(group);
+        group.InitParticles();
+        auto rest = GetRestPositions(group);
+
+        // 제자리에서 작게 떨림: 개수 경계 근처의 edge가 매 프레임 바뀌는지
+        long jitterResamples = 0;
+        auto start = Clock::now();
+        for (int frame = 0; frame < RESAMPLE_JITTER_FRAMES; ++frame) {
+            float scale = 1.0f + (frame % 2 ? RESAMPLE_JITTER : 0.0f);
+            for (int m = 0; m < group.GetMeshCount(); ++m) {
+                MeshData &meshData = group.GetMeshData(m);
+                for (size_t i = 0; i < rest[m].size(); ++i)
+                    meshData.vertices[i].position = rest[m][i] * scale;
+            }
+            group.UpdateParticles();
+            // 첫 번째 늘림은 실제 변화이므로 제외
+            if (frame > 1)
+                jitterResamples += group.m_numResamples;
+        }
+        double jitterMs = ms(start, Clock::now()) / RESAMPLE_JITTER_FRAMES;
+
+        // 부풀림 주기: 프레임 시간의 평균 / 최대와 미룬 후보 수
+        double totalMs = 0.0, maxMs = 0.0;
+        long swellResamples = 0;
+        int maxDeferred = 0;
+        for (int frame = 1; frame <= SAMPLING_FRAMES; ++frame) {
+            SwellMesh(group, rest, frame);
+            auto frameStart = Clock::now();
+            group.UpdateParticles();
+            double frameMs = ms(frameStart, Clock::now());
+            totalMs += frameMs;
+            maxMs = max(maxMs, frameMs);
+            swellResamples += group.m_numResamples;
+            maxDeferred = max(maxDeferred, group.m_numDeferredResamples);
+        }
+
+        cout << "hysteresis " << fixed << setprecision(2) << config.hysteresis
+             << ", budget " << setw(5) << config.budget << " : jitter "
+             << setprecision(1)
+             << double(jitterResamples) / (RESAMPLE_JITTER_FRAMES - 2)
+             << " resamples/frame " << setprecision(3) << jitterMs
+             << " ms, swell " << totalMs / SAMPLING_FRAMES << " ms (max "
+             << maxMs << "), " << setprecision(1)
+             << double(swellResamples) / SAMPLING_FRAMES
+             << " resamples/frame, max deferred " << maxDeferred
+             << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunTopologyBenchmark() {
+    using Clock = chrono::high_resolution_clock;
+    cout << "=== mesh construction (MakeSphere, edge dedup) ===" << endl
+         << "  resolution  triangles      edges   MakeSphere  edge rebuild"
+            "   (ns/triangle)"
+         << endl;
+
+    for (int n : TOPOLOGY_RESOLUTIONS) {
+        auto start = Clock::now();
+        MeshData meshData = GeometryGenerator::MakeSphere(0.5f, n, n);
+        auto built = Clock::now();
+
+        // LineCut 후와 같은 방식으로 triangle에서 edge를 다시 만듦
+        meshData.edges.clear();
+        EdgeMap edgeMap;
+        edgeMap.Reset(meshData.triangles.size() * 3 / 2);
+        for (auto &t : meshData.triangles)
+            for (int k = 0; k < 3; ++k)
+                t.edgeIndices[k] = GeometryGenerator::AddEdge(
+                    t.vertexIndices[k], t.vertexIndices[(k + 1) % 3],
+                    meshData, edgeMap);
+        auto rebuilt = Clock::now();
+
+        double numTriangles = double(meshData.triangles.size());
+        cout << setw(6) << n << " x " << left << setw(4) << n << right
+             << setw(10) << meshData.triangles.size() << setw(11)
+             << meshData.edges.size() << fixed << setprecision(1)
+             << setw(13)
+             << chrono::duration<double, nano>(built - start).count() /
+                    numTriangles
+             << setw(14)
+             << chrono::duration<double, nano>(rebuilt - built).count() /
+                    numTriangles
+             << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunHalfEdgeBenchmark() {
+    using Clock = chrono::high_resolution_clock;
+    cout << "=== half-edge topology (MakeSphere) ===" << endl
+         << "  resolution   build  loops   1-ring  edge scan       split"
+            "     rebuild  valid"
+         << endl
+         << "              (ns/tri)        (ns/vertex)          (us/split)"
+            "        (ms)"
+         << endl;
+
+    for (int n : TOPOLOGY_RESOLUTIONS) {
+        MeshData meshData = GeometryGenerator::MakeSphere(0.5f, n, n);
+        HalfEdgeMesh &halfEdges = meshData.halfEdges;
+        const uint32_t numVertices = uint32_t(meshData.vertices.size());
+
+        auto start = Clock::now();
+        halfEdges.Build(meshData);
+        auto built = Clock::now();
+
+        vector<uint32_t> loopOffsets;
+        vector<int> loopHalfEdges;
+        halfEdges.GetBoundaryLoops(loopOffsets, loopHalfEdges);
+
+        // 모든 vertex의 1-ring (half-edge) / 일부 vertex만 edge 전체 검색
+        // 두 방법으로 센 이웃 수가 같아야 함
+        vector<int> degrees(numVertices, 0);
+        auto ringStart = Clock::now();
+        for (uint32_t v = 0; v < numVertices; ++v)
+            halfEdges.ForEachNeighbor(v, [&](uint32_t) { ++degrees[v]; });
+        auto ringEnd = Clock::now();
+        bool valid = true;
+        for (int q = 0; q < HALF_EDGE_SCAN_QUERIES; ++q) {
+            const uint32_t v = uint32_t(q) * (numVertices - 1) /
+                               (HALF_EDGE_SCAN_QUERIES - 1);
+            int degree = 0;
+            for (const auto &e : meshData.edges)
+                degree += e.index0 == v || e.index1 == v;
+            valid = valid && degree == degrees[v];
+        }
+        auto scanEnd = Clock::now();
+
+        // 흩어진 edge를 가운데서 나눔. 나눈 뒤 전체를 다시 만든 것과 비교
+        const uint32_t numEdges = uint32_t(meshData.edges.size());
+        halfEdges.ReserveSplits(meshData, HALF_EDGE_SPLITS);
+        auto splitStart = Clock::now();
+        for (int i = 0; i < HALF_EDGE_SPLITS; ++i) {
+            const uint32_t e = uint32_t((uint64_t(i) * 7919) % numEdges);
+            Vertex v = meshData.vertices[meshData.edges[e].index0];
+            v.position = (v.position +
+                          meshData.vertices[meshData.edges[e].index1]
+                              .position) *
+                         0.5f;
+            meshData.vertices.push_back(v);
+            halfEdges.SplitEdge(meshData, e,
+                                uint32_t(meshData.vertices.size() - 1));
+        }
+        auto splitEnd = Clock::now();
+        valid = valid && halfEdges.Validate(meshData);
+        auto rebuildStart = Clock::now();
+        halfEdges.Build(meshData);
+        auto rebuildEnd = Clock::now();
+
+        cout << setw(6) << n << " x " << left << setw(4) << n << right
+             << fixed << setprecision(1) << setw(8)
+             << chrono::duration<double, nano>(built - start).count() /
+                    double(meshData.triangles.size() -
+                           2 * HALF_EDGE_SPLITS)
+             << setw(7) << loopOffsets.size() - 1 << setw(9)
+             << chrono::duration<double, nano>(ringEnd - ringStart).count() /
+                    numVertices
+             << setw(11)
+             << chrono::duration<double, nano>(scanEnd - ringEnd).count() /
+                    HALF_EDGE_SCAN_QUERIES
+             << setprecision(3) << setw(12)
+             << chrono::duration<double, micro>(splitEnd - splitStart)
+                        .count() /
+                    HALF_EDGE_SPLITS
+             << setw(12)
+             << chrono::duration<double, milli>(rebuildEnd - rebuildStart)
+                    .count()
+             << "  " << (valid && halfEdges.Validate(meshData) ? "yes" : "NO")
+             << defaultfloat << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunSceneBenchmark(const string &name,
+                                     const vector<MeshData> &meshes) {
+    cout << "=== " << name << " scene step (" << SCENE_GROUPS
+         << " groups) ===" << endl;
+
+    const int solverTypes[] = {PBD_SOLVER_GAUSS_SEIDEL,
+                               PBD_SOLVER_COLORED_GAUSS_SEIDEL,
+                               PBD_SOLVER_JACOBI};
+
+    vector<vector<float>> reference(SCENE_GROUPS);
+    for (int parallel = 0; parallel < 2; ++parallel) {
+        vector<BasicMeshGroup> groups(SCENE_GROUPS);
+        SimulationScene scene;
+        scene.m_parallel = parallel != 0;
+        for (int g = 0; g < SCENE_GROUPS; ++g) {
+            groups[g].InitializeSimulation(meshes);
+            groups[g].m_solverType = solverTypes[g % 3];
+            groups[g].m_numIterations = BENCHMARK_ITERATIONS;
+            groups[g].m_volumePressure = 1.1f;
+            scene.Register(&groups[g]);
+        }
+
+        double stepMs = 0.0;
+        vector<double> groupMs(SCENE_GROUPS, 0.0);
+        for (int f = 0; f < BENCHMARK_FRAMES; ++f) {
+            scene.Step(BENCHMARK_DT);
+            stepMs += scene.GetStepTimeMs();
+            for (int g = 0; g < SCENE_GROUPS; ++g)
+                groupMs[g] += scene.GetGroupTimeMs(g);
+        }
+
+        // 그룹끼리 공유하는 상태가 없으므로 순서대로 실행한 결과와 같아야 함
+        bool identical = true;
+        for (int g = 0; g < SCENE_GROUPS; ++g) {
+            vector<float> positions;
+            for (int m = 0; m < groups[g].GetMeshCount(); ++m) {
+                const ParticleState &p = groups[g].GetMeshData(m).particles;
+                positions.insert(positions.end(), p.x.begin(), p.x.end());
+                positions.insert(positions.end(), p.y.begin(), p.y.end());
+                positions.insert(positions.end(), p.z.begin(), p.z.end());
+            }
+            if (!parallel)
+                reference[g] = positions;
+            else
+                identical = identical && positions == reference[g];
+        }
+
+        cout << (parallel ? "Parallel" : "Serial  ") << " : " << fixed
+             << setprecision(3) << stepMs / BENCHMARK_FRAMES << " ms/frame (";
+        for (int g = 0; g < SCENE_GROUPS; ++g)
+            cout << (g ? ", " : "") << SOLVER_NAMES[solverTypes[g % 3]] << " "
+                 << groupMs[g] / BENCHMARK_FRAMES;
+        cout << ")" << defaultfloat;
+        if (parallel)
+            cout << (identical ? ", bit-identical" : ", DIFFERENT");
+        cout << endl;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::RunSolverBenchmark(const string &name,
+                                      const vector<MeshData> &meshes) {
+    size_t numVertices = 0, numEdges = 0;
+    for (const auto &m : meshes) {
+        numVertices += m.particles.Size();
+        numEdges += m.edges.size();
+    }
+
+    cout << "=== " << name << " (vertices " << numVertices << ", edges "
+         << numEdges << ") ===" << endl;
+
+    SolverResult serial = RunSolver(meshes, PBD_SOLVER_GAUSS_SEIDEL, 1);
+    cout << fixed << setprecision(3);
+    cout << "Gauss-Seidel          : " << serial.distanceMs
+         << " ms/sweep, strain max " << serial.maxStrain << " rms "
+         << serial.rmsStrain << endl;
+
+    const int maxThreads = ThreadPool::Get().GetNumThreads();
+    for (int numThreads = 1;; numThreads = min(numThreads * 2, maxThreads)) {
+        SolverResult colored =
+            RunSolver(meshes, PBD_SOLVER_COLORED_GAUSS_SEIDEL, numThreads);
+        cout << "Colored GS " << setw(2) << numThreads
+             << " threads : " << colored.distanceMs << " ms/sweep, speedup "
+             << serial.distanceMs / colored.distanceMs << "x, strain max "
+             << colored.maxStrain << " rms " << colored.rmsStrain << endl;
+        if (numThreads == maxThreads)
+            break;
+    }
+    cout << endl;
+}
+
+void PBDBenchmark::Run(const string &basePath, const string &filename) {
+    cout << "PBD benchmark: " << ThreadPool::Get().GetNumThreads()
+         << " threads available" << endl
+         << endl;
+
+    RunTopologyBenchmark();
+    RunHalfEdgeBenchmark();
+
+    // 반복 / 충돌 benchmark의 작은 장면 (커밋 기록의 수치는 이 장면 기준)
+    vector<MeshData> smallSphere = {
+        GeometryGenerator::MakeSphere(0.5f, 64, 64)};
+    RunChebyshevBenchmark("MakeSphere(0.5, 64, 64)", smallSphere);
+    RunMultigridBenchmark("MakeSphere(0.5, 64, 64)", smallSphere);
+    RunSelfCollisionBenchmark("MakeSphere(0.5, 64, 64)", smallSphere);
+    RunColliderBenchmark("MakeSphere(0.5, 64, 64)", smallSphere);
+
+    vector<MeshData> sphere = {GeometryGenerator::MakeSphere(0.5f, 256, 256)};
+    RunKernelBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunSolverBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunVolumeBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunVolumeTrackingBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunConvergenceBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunChebyshevBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunMultigridBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunSubstepBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunEarlyTerminationBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunSleepBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunSelfCollisionBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunColliderBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunReorderBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunBlockedBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunSamplingBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunCompactionBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunBarycentricBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunResampleBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+    RunSceneBenchmark("MakeSphere(0.5, 256, 256)", sphere);
+
+    auto meshes = GeometryGenerator::ReadFromFile(basePath, filename);
+    if (!meshes.empty()) {
+        RunKernelBenchmark(filename, meshes);
+        RunSolverBenchmark(filename, meshes);
+        RunVolumeBenchmark(filename, meshes);
+        RunVolumeTrackingBenchmark(filename, meshes);
+        RunConvergenceBenchmark(filename, meshes);
+        RunChebyshevBenchmark(filename, meshes);
+        RunMultigridBenchmark(filename, meshes);
+        RunSubstepBenchmark(filename, meshes);
+        RunEarlyTerminationBenchmark(filename, meshes);
+        RunSleepBenchmark(filename, meshes);
+        RunSelfCollisionBenchmark(filename, meshes);
+        RunColliderBenchmark(filename, meshes);
+        RunReorderBenchmark(
+            filename + " (file order)",
+            GeometryGenerator::ReadFromFile(basePath, filename,
+                                            MESH_ORDER_NONE));
+        RunBlockedBenchmark(filename, meshes);
+        RunSamplingBenchmark(filename, meshes);
+        RunCompactionBenchmark(filename, meshes);
+        RunBarycentricBenchmark(filename, meshes);
+        RunResampleBenchmark(filename, meshes);
+        RunSceneBenchmark(filename, meshes);
+    }
+}
+
+} // namespace jhm
@@ -0,0 +1,119 @@
+﻿#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MeshData.h"
+
+namespace jhm {
+
+// 창을 띄우지 않고 PBD 솔버 성능을 측정
+// main.exe --benchmark [basePath filename]
+class PBDBenchmark {
+  public:
+    static void Run(const std::string &basePath, const std::string &filename);
+
+    // Gauss-Seidel(직렬) 대비 Colored Gauss-Seidel의 스레드 수별 speedup
+    static void RunSolverBenchmark(const std::string &name,
+                                   const std::vector<MeshData> &meshes);
+
+    // computeVolumeConstraintScaling의 스레드 수별 시간과 결과 일치 여부
+    static void RunVolumeBenchmark(const std::string &name,
+                                   const std::vector<MeshData> &meshes);
+
+    // 호출마다 일부 vertex만 움직일 때 전체 계산 / 증분 갱신의
+    // computeVolumeConstraintScaling 시간, 결과 차이, VERIFY 모드의 최대 오차
+    static void RunVolumeTrackingBenchmark(
+        const std::string &name, const std::vector<MeshData> &meshes);
+
+    // Colored GS distance kernel (Scalar / SSE4 / AVX2)의 scalar 대비 오차와
+    // 단일 스레드 edges/second
+    static void RunKernelBenchmark(const std::string &name,
+                                   const std::vector<MeshData> &meshes);
+
+    // 흐트러뜨린 위치에서 residual이 tolerance 아래로 내려갈 때까지의
+    // 반복 횟수 (Gauss-Seidel / Colored / Jacobi)
+    static void RunConvergenceBenchmark(const std::string &name,
+                                        const std::vector<MeshData> &meshes);
+
+    // 전체를 늘린 상태(긴 파장의 오차)에서 flat Gauss-Seidel과
+    // hierarchical(multigrid) 반복의 residual, hierarchy 생성 / LineCut 후
+    // 부분 재생성 시간
+    static void RunMultigridBenchmark(const std::string &name,
+                                      const std::vector<MeshData> &meshes);
+
+    // Chebyshev 가속 유무에 따른 반복 횟수별 residual
+    static void RunChebyshevBenchmark(const std::string &name,
+                                      const std::vector<MeshData> &meshes);
+
+    // 같은 반복 예산(substeps x iterations)에서 XPBD substep 수에 따른
+    // 비용과 strain, compliance별 Gauss-Seidel / Jacobi의 strain 비율
+    static void RunSubstepBenchmark(const std::string &name,
+                                    const std::vector<MeshData> &meshes);
+
+    // 정지 상태에서 residual 기반 early termination이 줄이는 반복 횟수
+    static void RunEarlyTerminationBenchmark(
+        const std::string &name, const std::vector<MeshData> &meshes);
+
+    // 정지 상태에서 island가 잠들기까지의 프레임 수, 잠들기 전/후 프레임
+    // 시간, 파라미터 변경 시 다시 깨어나는지
+    static void RunSleepBenchmark(const std::string &name,
+                                  const std::vector<MeshData> &meshes);
+
+    // 위쪽 절반을 아래로 밀어 넣은 풍선에서 self collision 유무에 따른
+    // 겹친 particle 쌍 수와 broadphase / narrowphase 시간
+    static void RunSelfCollisionBenchmark(const std::string &name,
+                                          const std::vector<MeshData> &meshes);
+
+    // SDF grid bake 시간, batch Sample의 ns/query와 해석적 거리 대비 오차,
+    // 중력으로 바닥 / capsule / SDF collider 위에 떨어뜨렸을 때의 관통 깊이와
+    // broadphase가 걸러낸 collider 수
+    static void RunColliderBenchmark(const std::string &name,
+                                     const std::vector<MeshData> &meshes);
+
+    // 입력 순서 / 무작위로 섞은 순서 / Morton / RCM vertex 순서별 solver
+    // sweep 시간과 edge 양 끝 vertex 번호 차이 (메모리 상 거리)
+    static void RunReorderBenchmark(const std::string &name,
+                                    const std::vector<MeshData> &meshes);
+
+    // 일반 / colored Gauss-Seidel과 vertex 구간 block 단위 Gauss-Seidel
+    // (block 안 반복 횟수별)의 반복 횟수별 residual과 반복당 시간
+    static void RunBlockedBenchmark(const std::string &name,
+                                    const std::vector<MeshData> &meshes);
+
+    // InitParticles 시간, 부풀렸다 줄이면서 다시 sampling하는 UpdateParticles
+    // 의 스레드 수별 시간과 결과 일치 여부, 주기별 vertex slot 수가 첫 주기
+    // 이하인지, boundary particle 데이터를 포함한 MeshData 복사 / 해제 시간
+    static void RunSamplingBenchmark(const std::string &name,
+                                     const std::vector<MeshData> &meshes);
+
+    // 부풀림 주기로 흩어진 particle slot의 compaction 시간과 줄어든 메모리,
+    // 전후 UpdateParticles 시간, 기본 threshold로 자동 compaction한 횟수
+    static void RunCompactionBenchmark(const std::string &name,
+                                       const std::vector<MeshData> &meshes);
+
+    // barycentric 좌표로 boundary particle을 계산하는 kernel별 시간과 scalar
+    // 대비 오차, resampling이 없는 프레임의 UpdateParticles 시간
+    static void RunBarycentricBenchmark(const std::string &name,
+                                        const std::vector<MeshData> &meshes);
+
+    // hysteresis / 프레임 예산별로 제자리 떨림에서 매 프레임 resampling되는
+    // 수, 부풀림 주기의 UpdateParticles 평균 / 최대 시간과 미룬 후보 수
+    static void RunResampleBenchmark(const std::string &name,
+                                     const std::vector<MeshData> &meshes);
+
+    // 해상도를 올려 가며 MakeSphere 생성 시간과 triangle에서 edge를 다시
+    // 만드는 시간 (LineCut 후와 같은 경로)의 triangle당 시간
+    static void RunTopologyBenchmark();
+
+    // 해상도별 half-edge 생성 시간, 경계 loop 수, 1-ring 질의 (half-edge /
+    // edge 전체 검색), edge split 1회 시간과 전체 재생성 시간, split 후 검증
+    static void RunHalfEdgeBenchmark();
+
+    // SimulationScene: 여러 그룹을 순서대로 / 동시에 시뮬레이션한 시간과
+    // 그룹별 결과 일치 여부
+    static void RunSceneBenchmark(const std::string &name,
+                                  const std::vector<MeshData> &meshes);
+};
+
+} // namespace jhm
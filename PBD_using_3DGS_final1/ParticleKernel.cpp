@@ -0,0 +1,152 @@
+﻿#include "ParticleKernel.h"
+
+#include <cmath>
+
+#include "CpuFeatures.h"
+
+#if PBD_X86
+#include <immintrin.h>
+#endif
+
+namespace jhm {
+
+namespace {
+
+// AVX2 kernel은 Triangle을 UINT 6개(vertexIndices, edgeIndices)로 읽음
+static_assert(sizeof(Triangle) == 6 * sizeof(UINT),
+              "Triangle layout changed");
+
+void EvaluateScalar(const ParticleCorners &c, const Triangle *triangles,
+                    const uint32_t *triangle, const float *u, const float *v,
+                    Vertex *out, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        const UINT *corner = triangles[triangle[i]].vertexIndices;
+        const uint32_t a = corner[0], b = corner[1], k = corner[2];
+        const float w0 = u[i], w1 = v[i], w2 = 1.0f - u[i] - v[i];
+
+        Vertex &o = out[i];
+        o.position.x = w0 * c.x[a] + w1 * c.x[b] + w2 * c.x[k];
+        o.position.y = w0 * c.y[a] + w1 * c.y[b] + w2 * c.y[k];
+        o.position.z = w0 * c.z[a] + w1 * c.z[b] + w2 * c.z[k];
+
+        float nx = w0 * c.nx[a] + w1 * c.nx[b] + w2 * c.nx[k];
+        float ny = w0 * c.ny[a] + w1 * c.ny[b] + w2 * c.ny[k];
+        float nz = w0 * c.nz[a] + w1 * c.nz[b] + w2 * c.nz[k];
+        float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+        float inv = length > 0.0f ? 1.0f / length : 0.0f;
+        o.normal = Vector3(nx * inv, ny * inv, nz * inv);
+
+        o.texcoord.x = w0 * c.tu[a] + w1 * c.tu[b] + w2 * c.tu[k];
+        o.texcoord.y = w0 * c.tv[a] + w1 * c.tv[b] + w2 * c.tv[k];
+    }
+}
+
+#if PBD_X86
+// 꼭짓점 세 개의 속성을 gather해서 가중치로 섞음
+PBD_TARGET_AVX2 inline __m256 Blend(const float *attribute, __m256i a,
+                                    __m256i b, __m256i k, __m256 w0,
+                                    __m256 w1, __m256 w2) {
+    __m256 r = _mm256_mul_ps(w2, _mm256_i32gather_ps(attribute, k, 4));
+    r = _mm256_fmadd_ps(w1, _mm256_i32gather_ps(attribute, b, 4), r);
+    return _mm256_fmadd_ps(w0, _mm256_i32gather_ps(attribute, a, 4), r);
+}
+
+// 처리한 particle 수를 반환 (나머지는 scalar로 처리)
+PBD_TARGET_AVX2 int EvaluateAVX2(const ParticleCorners &c,
+                                 const Triangle *triangles,
+                                 const uint32_t *triangle, const float *u,
+                                 const float *v, Vertex *out, int count) {
+    const int *triangleData = reinterpret_cast<const int *>(triangles);
+    const __m256i six = _mm256_set1_epi32(6);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256 oneF = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    alignas(32) float result[8][8];
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i t = _mm256_mullo_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(triangle + i)),
+            six);
+        __m256i a = _mm256_i32gather_epi32(triangleData, t, 4);
+        t = _mm256_add_epi32(t, one);
+        __m256i b = _mm256_i32gather_epi32(triangleData, t, 4);
+        t = _mm256_add_epi32(t, one);
+        __m256i k = _mm256_i32gather_epi32(triangleData, t, 4);
+
+        __m256 w0 = _mm256_loadu_ps(u + i);
+        __m256 w1 = _mm256_loadu_ps(v + i);
+        __m256 w2 = _mm256_sub_ps(_mm256_sub_ps(oneF, w0), w1);
+
+        _mm256_store_ps(result[0], Blend(c.x.data(), a, b, k, w0, w1, w2));
+        _mm256_store_ps(result[1], Blend(c.y.data(), a, b, k, w0, w1, w2));
+        _mm256_store_ps(result[2], Blend(c.z.data(), a, b, k, w0, w1, w2));
+
+        __m256 nx = Blend(c.nx.data(), a, b, k, w0, w1, w2);
+        __m256 ny = Blend(c.ny.data(), a, b, k, w0, w1, w2);
+        __m256 nz = Blend(c.nz.data(), a, b, k, w0, w1, w2);
+        __m256 length = _mm256_sqrt_ps(_mm256_fmadd_ps(
+            nz, nz, _mm256_fmadd_ps(ny, ny, _mm256_mul_ps(nx, nx))));
+        __m256 inv = _mm256_and_ps(_mm256_div_ps(oneF, length),
+                                   _mm256_cmp_ps(length, zero, _CMP_GT_OQ));
+        _mm256_store_ps(result[3], _mm256_mul_ps(nx, inv));
+        _mm256_store_ps(result[4], _mm256_mul_ps(ny, inv));
+        _mm256_store_ps(result[5], _mm256_mul_ps(nz, inv));
+
+        _mm256_store_ps(result[6], Blend(c.tu.data(), a, b, k, w0, w1, w2));
+        _mm256_store_ps(result[7], Blend(c.tv.data(), a, b, k, w0, w1, w2));
+
+        // Vertex는 AoS이므로 lane별로 씀
+        for (int j = 0; j < 8; ++j) {
+            Vertex &o = out[i + j];
+            o.position = Vector3(result[0][j], result[1][j], result[2][j]);
+            o.normal = Vector3(result[3][j], result[4][j], result[5][j]);
+            o.texcoord = Vector2(result[6][j], result[7][j]);
+        }
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+void ParticleCorners::Resize(size_t count) {
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    nx.resize(count);
+    ny.resize(count);
+    nz.resize(count);
+    tu.resize(count);
+    tv.resize(count);
+}
+
+void ParticleCorners::Copy(const Vertex *vertices, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const Vertex &vertex = vertices[i];
+        x[i] = vertex.position.x;
+        y[i] = vertex.position.y;
+        z[i] = vertex.position.z;
+        nx[i] = vertex.normal.x;
+        ny[i] = vertex.normal.y;
+        nz[i] = vertex.normal.z;
+        tu[i] = vertex.texcoord.x;
+        tv[i] = vertex.texcoord.y;
+    }
+}
+
+void EvaluateParticleBatch(const ParticleCorners &corners,
+                           const Triangle *triangles,
+                           const uint32_t *triangle, const float *u,
+                           const float *v, Vertex *out, int count,
+                           DistanceKernelType type) {
+    int done = 0;
+#if PBD_X86
+    if (ResolveDistanceKernel(type) == DISTANCE_KERNEL_AVX2)
+        done = EvaluateAVX2(corners, triangles, triangle, u, v, out, count);
+#endif
+    EvaluateScalar(corners, triangles, triangle, u, v, out, done, count);
+}
+
+} // namespace jhm
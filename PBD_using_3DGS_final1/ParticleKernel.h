@@ -0,0 +1,33 @@
+﻿#pragma once
+
+#include <cstdint>
+
+#include "DistanceKernel.h"
+#include "ParticleState.h"
+#include "Triangle.h"
+#include "Vertex.h"
+
+namespace jhm {
+
+// boundary particle 계산에 쓰는 mesh vertex 속성 (SoA 사본)
+struct ParticleCorners {
+    AlignedVector<float> x, y, z;    // 위치
+    AlignedVector<float> nx, ny, nz; // normal
+    AlignedVector<float> tu, tv;     // texcoord
+
+    void Resize(size_t count);
+    // vertices[begin ~ end)의 위치, normal, texcoord를 같은 번호로 복사
+    void Copy(const Vertex *vertices, size_t begin, size_t end);
+};
+
+// particle [0, count)의 위치 / normal / texcoord를 barycentric 좌표로 계산해
+// out[i]에 씀. particle i는 triangles[triangle[i]]의 꼭짓점 c0, c1, c2를
+// u[i], v[i], 1 - u[i] - v[i]로 섞은 점 (normal은 섞은 뒤 정규화)
+// SSE4는 scalar로 처리 (AVX2만 gather 명령이 있음)
+void EvaluateParticleBatch(const ParticleCorners &corners,
+                           const Triangle *triangles,
+                           const uint32_t *triangle, const float *u,
+                           const float *v, Vertex *out, int count,
+                           DistanceKernelType type);
+
+} // namespace jhm
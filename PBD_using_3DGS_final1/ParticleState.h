@@ -0,0 +1,107 @@
+﻿#pragma once
+
+#include <cstdlib>
+#include <directxtk/SimpleMath.h>
+#include <new>
+#include <vector>
+
+namespace jhm {
+
+using DirectX::SimpleMath::Vector3;
+
+// cache line(64 bytes) 단위로 정렬된 메모리 할당 (SIMD load/store 용)
+template <typename T, size_t ALIGNMENT = 64> struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U> struct rebind {
+        using other = AlignedAllocator<U, ALIGNMENT>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, ALIGNMENT> &) {}
+
+    T *allocate(size_t n) {
+        size_t bytes = (n * sizeof(T) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+#ifdef _MSC_VER
+        void *p = _aligned_malloc(bytes, ALIGNMENT);
+#else
+        void *p = std::aligned_alloc(ALIGNMENT, bytes);
+#endif
+        if (!p)
+            throw std::bad_alloc();
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, size_t) {
+#ifdef _MSC_VER
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, ALIGNMENT> &) const {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, ALIGNMENT> &) const {
+        return false;
+    }
+};
+
+template <typename T> using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// PBD 시뮬레이션 상태 (Structure of Arrays)
+// 솔버는 Vertex(렌더링용, sh[48] 포함) 대신 필요한 배열만 연속으로 읽는다.
+// Vertex::position은 렌더링 직전에 GatherParticlePositions()로 복사
+struct ParticleState {
+    AlignedVector<float> x, y, z;    // 현재 위치
+    AlignedVector<float> px, py, pz; // 예측 위치
+    AlignedVector<float> vx, vy, vz; // 속도
+    AlignedVector<float> invMass;
+
+    size_t Size() const { return x.size(); }
+
+    void Resize(size_t n) {
+        for (auto *a : {&x, &y, &z, &px, &py, &pz, &vx, &vy, &vz})
+            a->resize(n, 0.0f);
+        invMass.resize(n, 1.0f);
+    }
+
+    void PushBack(const Vector3 &position, float mass = 1.0f) {
+        x.push_back(position.x);
+        y.push_back(position.y);
+        z.push_back(position.z);
+        px.push_back(position.x);
+        py.push_back(position.y);
+        pz.push_back(position.z);
+        for (auto *a : {&vx, &vy, &vz})
+            a->push_back(0.0f);
+        invMass.push_back(mass);
+    }
+
+    Vector3 Position(size_t i) const { return Vector3(x[i], y[i], z[i]); }
+    void SetPosition(size_t i, const Vector3 &v) {
+        x[i] = v.x;
+        y[i] = v.y;
+        z[i] = v.z;
+    }
+
+    Vector3 Predicted(size_t i) const { return Vector3(px[i], py[i], pz[i]); }
+    void SetPredicted(size_t i, const Vector3 &v) {
+        px[i] = v.x;
+        py[i] = v.y;
+        pz[i] = v.z;
+    }
+
+    Vector3 Velocity(size_t i) const { return Vector3(vx[i], vy[i], vz[i]); }
+    void SetVelocity(size_t i, const Vector3 &v) {
+        vx[i] = v.x;
+        vy[i] = v.y;
+        vz[i] = v.z;
+    }
+};
+
+} // namespace jhm
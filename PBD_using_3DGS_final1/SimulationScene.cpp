@@ -0,0 +1,52 @@
+﻿#include "SimulationScene.h"
+
+#include <chrono>
+
+#include "ThreadPool.h"
+
+namespace jhm {
+
+using namespace std;
+
+void SimulationScene::Register(BasicMeshGroup *group) {
+    group->m_colliders = &m_colliders;
+    m_groups.push_back(group);
+    m_groupTimeMs.push_back(0.0);
+}
+
+void SimulationScene::Clear() {
+    for (auto *group : m_groups)
+        group->m_colliders = nullptr;
+    m_groups.clear();
+    m_groupTimeMs.clear();
+    m_stepTimeMs = 0.0;
+}
+
+void SimulationScene::Step(float dt) {
+    using Clock = chrono::high_resolution_clock;
+
+    auto stepGroup = [&](int i) {
+        auto start = Clock::now();
+        m_groups[i]->Simulate(dt);
+        m_groups[i]->GatherParticlePositions();
+        m_groupTimeMs[i] =
+            chrono::duration<double, milli>(Clock::now() - start).count();
+    };
+
+    auto start = Clock::now();
+    if (m_parallel) {
+        // grain 1: 그룹 하나가 작업 하나
+        ThreadPool::Get().ParallelFor(0, GetGroupCount(), 1,
+                                      [&](int begin, int end) {
+                                          for (int i = begin; i < end; ++i)
+                                              stepGroup(i);
+                                      });
+    } else {
+        for (int i = 0; i < GetGroupCount(); ++i)
+            stepGroup(i);
+    }
+    m_stepTimeMs =
+        chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+} // namespace jhm
@@ -0,0 +1,44 @@
+﻿#pragma once
+
+#include <vector>
+
+#include "BasicMeshGroup.h"
+#include "ColliderSet.h"
+
+namespace jhm {
+
+// 등록된 모든 BasicMeshGroup을 한 프레임씩 동시에 시뮬레이션
+// 그룹마다 ThreadPool 작업 하나를 쓰고, 그룹 안의 solver는 다시 ParallelFor로
+// 나눠 실행한다 (중첩 허용). 그룹끼리는 데이터를 공유하지 않고, static
+// collider만 읽기 전용으로 공유한다.
+class SimulationScene {
+  public:
+    // 그룹이 scene의 collider를 사용하도록 연결
+    void Register(BasicMeshGroup *group);
+    void Clear();
+
+    // 모든 그룹: Simulate(dt) -> GatherParticlePositions()
+    // GPU 버퍼 업데이트는 하지 않으므로 호출 후 보이는 그룹만 업로드하면 됨
+    void Step(float dt);
+
+    int GetGroupCount() const { return int(m_groups.size()); }
+    BasicMeshGroup *GetGroup(int index) { return m_groups[index]; }
+
+    // 마지막 Step에서 그룹별 / 전체 소요 시간 (ms)
+    double GetGroupTimeMs(int index) const { return m_groupTimeMs[index]; }
+    double GetStepTimeMs() const { return m_stepTimeMs; }
+
+    // Step 중에는 바꾸지 않음
+    ColliderSet &GetColliders() { return m_colliders; }
+
+  public:
+    bool m_parallel = true; // false면 그룹을 순서대로 시뮬레이션
+
+  private:
+    std::vector<BasicMeshGroup *> m_groups;
+    ColliderSet m_colliders;
+    std::vector<double> m_groupTimeMs;
+    double m_stepTimeMs = 0.0;
+};
+
+} // namespace jhm
@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace jhm {
+
+// 한 번의 sweep 동안 보정 전 edge strain (|C| / restLength) 누적
+struct StrainAccumulator {
+    float maxStrain = 0.0f;
+    double sumSquared = 0.0;
+    size_t count = 0;
+
+    void Add(float strain) {
+        maxStrain = std::max(maxStrain, strain);
+        sumSquared += double(strain) * strain;
+        ++count;
+    }
+
+    void Merge(const StrainAccumulator &other) {
+        maxStrain = std::max(maxStrain, other.maxStrain);
+        sumSquared += other.sumSquared;
+        count += other.count;
+    }
+
+    float Rms() const {
+        return count > 0 ? float(std::sqrt(sumSquared / count)) : 0.0f;
+    }
+};
+
+// 마지막 constraint 반복의 residual (각 constraint 보정 직전 기준)
+struct SolverResidual {
+    float maxStrain = 0.0f;
+    float rmsStrain = 0.0f;
+    float volumeError = 0.0f; // |V - V_target| / V_target
+    int iterations = 0;       // 이번 프레임에 수행한 반복 횟수 (substep 합)
+
+    // early termination 판정에 사용하는 값
+    float Value() const { return std::max(rmsStrain, volumeError); }
+};
+
+} // namespace jhm
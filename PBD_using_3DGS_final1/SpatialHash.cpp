@@ -0,0 +1,135 @@
+﻿#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ThreadPool.h"
+
+namespace jhm {
+
+namespace {
+
+const int HASH_GRAIN_SIZE = 1024;
+
+int CellCoord(float v, float invCellSize) {
+    return int(std::floor(v * invCellSize));
+}
+
+} // namespace
+
+uint32_t SpatialHash::Hash(int ix, int iy, int iz) const {
+    return (uint32_t(ix) * 73856093u ^ uint32_t(iy) * 19349663u ^
+            uint32_t(iz) * 83492791u) &
+           m_tableMask;
+}
+
+void SpatialHash::Build(const float *x, const float *y, const float *z,
+                        int count, float cellSize, int numThreads) {
+    m_cellSize = cellSize;
+    m_invCellSize = 1.0f / cellSize;
+
+    // table 크기: particle 수의 2배 이상인 2의 거듭제곱
+    uint32_t tableSize = 1;
+    while (tableSize < uint32_t(2 * std::max(count, 1)))
+        tableSize <<= 1;
+    m_tableMask = tableSize - 1;
+
+    // 1) particle별 hash
+    m_cellOf.resize(count);
+    ThreadPool::Get().ParallelFor(
+        0, count, HASH_GRAIN_SIZE,
+        [&](int begin, int end) {
+            for (int i = begin; i < end; ++i)
+                m_cellOf[i] = Hash(CellCoord(x[i], m_invCellSize),
+                                   CellCoord(y[i], m_invCellSize),
+                                   CellCoord(z[i], m_invCellSize));
+        },
+        numThreads);
+
+    // 2) counting sort
+    m_cellStart.assign(tableSize + 1, 0);
+    for (int i = 0; i < count; ++i)
+        ++m_cellStart[m_cellOf[i] + 1];
+    for (uint32_t h = 0; h < tableSize; ++h)
+        m_cellStart[h + 1] += m_cellStart[h];
+
+    m_sorted.resize(count);
+    m_x.resize(count);
+    m_y.resize(count);
+    m_z.resize(count);
+    // m_cellStart[h]를 cursor로 쓰고 나면 한 칸씩 밀리므로 다시 되돌림
+    for (int i = 0; i < count; ++i) {
+        uint32_t k = m_cellStart[m_cellOf[i]]++;
+        m_sorted[k] = uint32_t(i);
+        m_x[k] = x[i];
+        m_y[k] = y[i];
+        m_z[k] = z[i];
+    }
+    for (uint32_t h = tableSize; h > 0; --h)
+        m_cellStart[h] = m_cellStart[h - 1];
+    m_cellStart[0] = 0;
+}
+
+void SpatialHash::FindPairs(float radius, const std::vector<uint64_t> *exclude,
+                            std::vector<uint64_t> &pairs, int numThreads) {
+    const int count = GetCount();
+    const float radius2 = radius * radius;
+    const int numBlocks = (count + HASH_GRAIN_SIZE - 1) / HASH_GRAIN_SIZE;
+    if (int(m_blockPairs.size()) < numBlocks)
+        m_blockPairs.resize(numBlocks);
+
+    // cell 순서로 순회해서 이웃 cell의 위치를 연속으로 읽음
+    ThreadPool::Get().ParallelFor(
+        0, count, HASH_GRAIN_SIZE,
+        [&](int begin, int end) {
+            std::vector<uint64_t> &blockPairs =
+                m_blockPairs[begin / HASH_GRAIN_SIZE];
+            blockPairs.clear();
+
+            uint32_t cells[27];
+            for (int k = begin; k < end; ++k) {
+                const uint32_t i = m_sorted[k];
+                const float px = m_x[k], py = m_y[k], pz = m_z[k];
+                const int ix = CellCoord(px, m_invCellSize);
+                const int iy = CellCoord(py, m_invCellSize);
+                const int iz = CellCoord(pz, m_invCellSize);
+
+                // 서로 다른 cell이 같은 hash일 수 있으므로 중복 제거
+                int numCells = 0;
+                for (int dz = -1; dz <= 1; ++dz)
+                    for (int dy = -1; dy <= 1; ++dy)
+                        for (int dx = -1; dx <= 1; ++dx)
+                            cells[numCells++] = Hash(ix + dx, iy + dy, iz + dz);
+                std::sort(cells, cells + numCells);
+                numCells = int(std::unique(cells, cells + numCells) - cells);
+
+                for (int c = 0; c < numCells; ++c) {
+                    for (uint32_t n = m_cellStart[cells[c]];
+                         n < m_cellStart[cells[c] + 1]; ++n) {
+                        const uint32_t j = m_sorted[n];
+                        if (j <= i)
+                            continue;
+                        float dx = m_x[n] - px;
+                        float dy = m_y[n] - py;
+                        float dz = m_z[n] - pz;
+                        if (dx * dx + dy * dy + dz * dz >= radius2)
+                            continue;
+
+                        uint64_t key = PairKey(i, j);
+                        if (exclude && std::binary_search(exclude->begin(),
+                                                          exclude->end(), key))
+                            continue;
+                        blockPairs.push_back(key);
+                    }
+                }
+            }
+        },
+        numThreads);
+
+    pairs.clear();
+    for (int b = 0; b < numBlocks; ++b)
+        pairs.insert(pairs.end(), m_blockPairs[b].begin(),
+                     m_blockPairs[b].end());
+}
+
+} // namespace jhm
@@ -0,0 +1,47 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ParticleState.h"
+
+namespace jhm {
+
+// 균일 격자 spatial hash (particle 간 충돌 broadphase)
+// Build: particle마다 cell hash 계산 -> counting sort로 cell 순서 배열 생성
+// FindPairs: 주변 27개 cell만 검사하므로 particle 수에 선형
+class SpatialHash {
+  public:
+    void Build(const float *x, const float *y, const float *z, int count,
+               float cellSize, int numThreads = 0);
+
+    // 거리가 radius(<= cellSize) 미만인 쌍의 key(i << 32 | j, i < j)를
+    // pairs에 저장 (스레드 수와 무관하게 같은 순서).
+    // exclude(정렬된 key)에 있는 쌍은 제외
+    void FindPairs(float radius, const std::vector<uint64_t> *exclude,
+                   std::vector<uint64_t> &pairs, int numThreads = 0);
+
+    int GetCount() const { return int(m_sorted.size()); }
+
+    static uint64_t PairKey(uint32_t a, uint32_t b) {
+        return a < b ? uint64_t(a) << 32 | b : uint64_t(b) << 32 | a;
+    }
+
+  private:
+    uint32_t Hash(int ix, int iy, int iz) const;
+
+  private:
+    float m_cellSize = 1.0f;
+    float m_invCellSize = 1.0f;
+    uint32_t m_tableMask = 0;
+
+    std::vector<uint32_t> m_cellOf;    // particle별 hash
+    std::vector<uint32_t> m_cellStart; // hash h: [m_cellStart[h], [h + 1])
+    std::vector<uint32_t> m_sorted;    // cell 순서 particle 번호
+    AlignedVector<float> m_x, m_y, m_z; // cell 순서 위치
+
+    // ParallelFor 블록별 결과 (블록 순서대로 합침)
+    std::vector<std::vector<uint64_t>> m_blockPairs;
+};
+
+} // namespace jhm
@@ -0,0 +1,140 @@
+﻿#include "ThreadPool.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace jhm {
+
+namespace {
+
+struct ParallelJob {
+    const std::function<void(int, int)> *func;
+    int begin;
+    int end;
+    int grainSize;
+    std::atomic<int> nextBlock{0};
+    std::atomic<int> activeHelpers{0};
+
+    void Run() {
+        const int numBlocks = (end - begin + grainSize - 1) / grainSize;
+        for (int b = nextBlock++; b < numBlocks; b = nextBlock++) {
+            int blockBegin = begin + b * grainSize;
+            int blockEnd = std::min(blockBegin + grainSize, end);
+            (*func)(blockBegin, blockEnd);
+        }
+    }
+};
+
+} // namespace
+
+ThreadPool &ThreadPool::Get() {
+    static ThreadPool pool;
+    return pool;
+}
+
+ThreadPool::ThreadPool(int numThreads) { StartWorkers(numThreads); }
+
+ThreadPool::~ThreadPool() { StopWorkers(); }
+
+void ThreadPool::SetNumThreads(int numThreads) {
+    StopWorkers();
+    StartWorkers(numThreads);
+}
+
+void ThreadPool::StartWorkers(int numThreads) {
+    if (numThreads <= 0)
+        numThreads = std::max(1, int(std::thread::hardware_concurrency()));
+
+    m_stop = false;
+    for (int i = 1; i < numThreads; ++i)
+        m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+void ThreadPool::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for (auto &w : m_workers)
+        w.join();
+    m_workers.clear();
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock,
+                             [this] { return m_stop || !m_tasks.empty(); });
+            if (m_stop && m_tasks.empty())
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+bool ThreadPool::RunPendingTask() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasks.empty())
+            return false;
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::ParallelFor(int begin, int end, int grainSize,
+                             const std::function<void(int, int)> &func,
+                             int maxThreads) {
+    if (end <= begin)
+        return;
+    grainSize = std::max(1, grainSize);
+
+    const int numBlocks = (end - begin + grainSize - 1) / grainSize;
+    int numThreads = GetNumThreads();
+    if (maxThreads > 0)
+        numThreads = std::min(numThreads, maxThreads);
+    const int numHelpers = std::min(numThreads, numBlocks) - 1;
+
+    // 블록이 하나거나 스레드가 하나면 바로 실행
+    if (numHelpers <= 0) {
+        for (int b = begin; b < end; b += grainSize)
+            func(b, std::min(b + grainSize, end));
+        return;
+    }
+
+    auto job = std::make_shared<ParallelJob>();
+    job->func = &func;
+    job->begin = begin;
+    job->end = end;
+    job->grainSize = grainSize;
+    job->activeHelpers = numHelpers;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int i = 0; i < numHelpers; ++i) {
+            m_tasks.emplace_back([job] {
+                job->Run();
+                --job->activeHelpers;
+            });
+        }
+    }
+    m_condition.notify_all();
+
+    job->Run();
+
+    // 남은 블록을 처리 중인 helper를 기다리는 동안 다른 작업 실행
+    while (job->activeHelpers > 0) {
+        if (!RunPendingTask())
+            std::this_thread::yield();
+    }
+}
+
+} // namespace jhm
@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jhm {
+
+// PBD 솔버에서 공용으로 사용하는 스레드 풀
+// ParallelFor를 호출한 스레드도 작업에 참여하고, 기다리는 동안 큐에 쌓인
+// 다른 작업을 대신 실행하므로 작업 안에서 다시 ParallelFor를 호출해도 된다.
+class ThreadPool {
+  public:
+    static ThreadPool &Get();
+
+    explicit ThreadPool(int numThreads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // 호출 스레드를 포함한 스레드 수 (0이면 하드웨어 스레드 수)
+    // 작업이 진행 중이지 않을 때만 호출
+    void SetNumThreads(int numThreads);
+    int GetNumThreads() const { return int(m_workers.size()) + 1; }
+
+    // [begin, end)를 grainSize 크기의 블록으로 나눠 func(blockBegin, blockEnd)
+    // 호출. 블록 경계는 스레드 수와 무관하게 항상 같다.
+    // maxThreads > 0 이면 그 수만큼의 스레드만 사용
+    void ParallelFor(int begin, int end, int grainSize,
+                     const std::function<void(int, int)> &func,
+                     int maxThreads = 0);
+
+  private:
+    void WorkerLoop();
+    bool RunPendingTask();
+    void StartWorkers(int numThreads);
+    void StopWorkers();
+
+  private:
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop = false;
+};
+
+} // namespace jhm
@@ -1,4 +1,4 @@
-#pragma once
+﻿#pragma once
 
 #include <directxtk/SimpleMath.h>
 #include <vector>
@@ -8,12 +8,13 @@ namespace jhm {
 struct Triangle {
     UINT vertexIndices[3];
     UINT edgeIndices[3];
+};
 
-    // Boundary Particle
-    std::vector<UINT> innerParticlesIndices;
+// Boundary Particle (MeshData::triangleParticles, triangles와 같은 번호)
+// 내부 particle의 vertex 번호는 MeshData::innerParticleIndices에 저장
+struct TriangleParticles {
     UINT shortEdgeIndex = -1;
     UINT numNormalParticles;
     UINT numShortEdgeParticles;
-    std::vector<UINT> lineParticles;
 };
 } // namespace hlab
@@ -3,13 +3,24 @@
 #include <windows.h>
 
 #include "ExampleApp.h"
+#include "PBDBenchmark.h"
 
 using namespace std;
 
 // main()은 앱을 초기화하고 실행시키는 기능만 합니다.
 // 콘솔창이 있으면 디버깅에 편리합니다.
 // 디버깅할 때 애매한 값들을 cout으로 출력해서 확인해보세요.
-int main() {
+int main(int argc, char *argv[]) {
+
+    // 창 없이 솔버 benchmark만 실행
+    // 예: PBD_using_3DGS_final1.exe --benchmark C:/Users/wjdgu/Desktop/OBJ/ dragon.obj
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        string basePath = argc > 3 ? argv[2] : "C:/Users/wjdgu/Desktop/OBJ/";
+        string filename = argc > 3 ? argv[3] : "dragon.obj";
+        jhm::PBDBenchmark::Run(basePath, filename);
+        return 0;
+    }
+
     jhm::ExampleApp exampleApp;
 
     if (!exampleApp.Initialize()) {